@@ -1,3 +1,6 @@
+set(LOG_CATALOG_EXECUTABLE "" CACHE FILEPATH
+  "log_catalog built for the build host, which exports the message catalogs of the executables when cross-compiling")
+
 function (add_project_library)
   set(options)
   set(oneValueArgs NAME)
@@ -7,6 +10,7 @@ function (add_project_library)
     PUBLIC_DEPENDENCIES 
     PRIVATE_INCLUDES 
     PUBLIC_INCLUDES
+    PUBLIC_DEFINITIONS
   )
 
   cmake_parse_arguments(LIB "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
@@ -18,6 +22,8 @@ function (add_project_library)
 
   target_link_libraries(${LIB_NAME} PUBLIC ${LIB_PUBLIC_DEPENDENCIES})
   target_link_libraries(${LIB_NAME} PRIVATE ${LIB_PRIVATE_DEPENDENCIES})
+
+  target_compile_definitions(${LIB_NAME} PUBLIC ${LIB_PUBLIC_DEFINITIONS})
   
   set_target_properties(
     ${LIB_NAME} PROPERTIES 
@@ -40,4 +46,38 @@ function(add_project_executable)
   target_link_libraries(${EXEC_NAME} PRIVATE ${EXEC_DEPENDENCIES})
   install(TARGETS ${EXEC_NAME} DESTINATION ${CMAKE_INSTALL_BINDIR}/${EXEC_NAME}/bin)
   install(DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/config/ DESTINATION ${CMAKE_INSTALL_BINDIR}/${EXEC_NAME}/etc)
+
+  # catalog of the modeled (non-verbose) messages the executable and the project libraries it links log, needed to
+  # decode them
+  if(CMAKE_CROSSCOMPILING)
+    # the log_catalog of this tree is built for the target, so it takes one built for the build host
+    if(NOT LOG_CATALOG_EXECUTABLE)
+      message(STATUS "${EXEC_NAME}: no message catalog, LOG_CATALOG_EXECUTABLE is not set")
+      return()
+    endif()
+    set(LOG_CATALOG ${LOG_CATALOG_EXECUTABLE})
+  else()
+    set(LOG_CATALOG $<TARGET_FILE:log_catalog>)
+    add_dependencies(${EXEC_NAME} log_catalog)
+  endif()
+
+  set(EXEC_BINARIES $<TARGET_FILE:${EXEC_NAME}>)
+  foreach(DEPENDENCY IN LISTS EXEC_DEPENDENCIES)
+    if(TARGET ${DEPENDENCY})
+      get_target_property(DEPENDENCY_TYPE ${DEPENDENCY} TYPE)
+      get_target_property(DEPENDENCY_IMPORTED ${DEPENDENCY} IMPORTED)
+      if(DEPENDENCY_TYPE STREQUAL "SHARED_LIBRARY" AND NOT DEPENDENCY_IMPORTED)
+        list(APPEND EXEC_BINARIES $<TARGET_FILE:${DEPENDENCY}>)
+      endif()
+    endif()
+  endforeach()
+
+  set(EXEC_CATALOG ${CMAKE_CURRENT_BINARY_DIR}/${EXEC_NAME}.catalog.json)
+  add_custom_command(
+    TARGET ${EXEC_NAME} POST_BUILD
+    COMMAND ${LOG_CATALOG} -o ${EXEC_CATALOG} ${EXEC_BINARIES}
+    BYPRODUCTS ${EXEC_CATALOG}
+    COMMENT "Exporting the message catalog of ${EXEC_NAME}"
+  )
+  install(FILES ${EXEC_CATALOG} DESTINATION ${CMAKE_INSTALL_BINDIR}/${EXEC_NAME}/etc)
 endfunction(add_project_executable)
@@ -0,0 +1,102 @@
+#ifndef VITO_AP_ASYNC_DISPATCHER_H_
+#define VITO_AP_ASYNC_DISPATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "ara/core/vector.h"
+#include "ara/log/coalescer.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logging_handler.h"
+#include "ara/log/ring_queue.h"
+
+namespace ara::log {
+namespace dlt {
+class Message;
+}
+
+/// @brief Hands finished messages from the logging threads to a writer thread, which emits them to the handlers.
+/// Logging then only costs an enqueue on the calling thread. The writer sleeps while the queue is empty and is woken
+/// by the producer that finds it sleeping, so a busy writer costs producers no system call. With a coalescer, the
+/// writer sleeps at most until the earliest coalescing window ends, to emit its record on time.
+class AsyncDispatcher {
+ public:
+  struct Statistics {
+    /// @brief number of messages discarded by the kDropNewest and kDropOldest policies
+    std::uint64_t dropped{0};
+    /// @brief number of times a producer waited for room under the kBlock policy
+    std::uint64_t blocked{0};
+  };
+
+  /// @brief Start the writer thread.
+  /// @param config the queue settings
+  /// @param handlers the handlers to emit to, which must outlive the dispatcher
+  /// @param coalescer if not null, the coalescer messages are emitted through, which must outlive the dispatcher and
+  /// is used by the writer thread alone until Stop() returns
+  AsyncDispatcher(const AsyncConfig& config, const core::Vector<std::unique_ptr<LoggingHandler>>& handlers,
+                  Coalescer* coalescer = nullptr);
+
+  AsyncDispatcher(const AsyncDispatcher&) = delete;
+  AsyncDispatcher& operator=(const AsyncDispatcher&) = delete;
+
+  ~AsyncDispatcher();
+
+  /// @brief Queue a message for the writer thread, applying the overflow policy if the queue is full.
+  /// Once stopped, the message is emitted on the calling thread instead, without coalescing, which producers cannot
+  /// share.
+  void Push(std::shared_ptr<dlt::Message> message);
+
+  /// @brief Join the writer thread, wait for the producers still pushing and emit what they queued. Calling it again
+  /// has no effect.
+  void Stop();
+
+  Statistics GetStatistics() const;
+
+ private:
+  /// @brief Push() without the accounting of pushing_.
+  void Enqueue(std::shared_ptr<dlt::Message> message);
+
+  void Run();
+
+  /// @brief Emit a message from the writer thread, or from Stop() once the writer thread has finished.
+  void Emit(const std::shared_ptr<dlt::Message>& message) const;
+
+  void EmitToSinks(const std::shared_ptr<dlt::Message>& message) const;
+
+  /// @brief Sleep until a message is queued, Stop() is called or deadline has passed.
+  void WaitForMessages(std::chrono::steady_clock::time_point deadline);
+
+  void WakeWriter();
+
+  void WaitForSpace();
+
+  void WakeProducers();
+
+ private:
+  const OverflowPolicy overflow_policy_;
+  const core::Vector<std::unique_ptr<LoggingHandler>>& handlers_;
+  Coalescer* const coalescer_;
+  RingQueue<std::shared_ptr<dlt::Message>> queue_;
+  std::atomic<bool> stopping_{false};
+  /// @brief number of producers inside Push(), which Stop() waits for, so that no message is left in the queue
+  std::atomic<std::uint32_t> pushing_{0};
+  /// @brief bumped under message_mutex_ to wake the writer; writer_waiting_ tells producers whether that is needed
+  std::mutex message_mutex_;
+  std::condition_variable message_wake_;
+  std::uint32_t message_signal_{0};
+  std::atomic<bool> writer_waiting_{false};
+  /// @brief bumped to wake blocked producers; waiting_producers_ tells the writer whether that is needed
+  std::atomic<std::uint32_t> space_signal_{0};
+  std::atomic<std::uint32_t> waiting_producers_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> blocked_{0};
+  std::thread writer_;
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_ASYNC_DISPATCHER_H_
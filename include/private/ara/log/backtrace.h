@@ -0,0 +1,44 @@
+#ifndef VITO_AP_BACKTRACE_H_
+#define VITO_AP_BACKTRACE_H_
+
+#include <cstddef>
+
+#include "ara/core/vector.h"
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_config.h"
+
+namespace ara::log {
+/// @brief Per-thread ring of the last messages of contexts in backtrace mode that were below their threshold. They are
+/// kept in binary form, unformatted, and emitted in front of the next Error or Fatal message of the thread, so that a
+/// failure comes with the details leading up to it.
+/// The ring owns its messages: capturing copies the headers and the used part of the payload into the oldest one, so
+/// the pooled message is released right away, and dumping emits pooled copies. The slots are allocated by the first
+/// captures of the thread and reused from then on.
+class Backtrace {
+ public:
+  /// @brief Return the ring of the calling thread, holding up to "Backtrace.Depth" messages.
+  static Backtrace& Local();
+
+  Backtrace(const Backtrace&) = delete;
+  Backtrace& operator=(const Backtrace&) = delete;
+
+  /// @brief Keep a copy of a message, replacing the oldest one once the ring is full.
+  void Capture(const dlt::Message& message);
+
+  /// @brief Emit the kept messages, oldest first, to sinks and empty the ring.
+  /// @param sinks the sinks of the message triggering the dump
+  void Dump(SinkMask sinks);
+
+ private:
+  explicit Backtrace(std::size_t depth);
+
+ private:
+  const std::size_t depth_;
+  core::Vector<dlt::Message> slots_;
+  /// @brief the slot the next message is captured into
+  std::size_t next_{0};
+  std::size_t size_{0};
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_BACKTRACE_H_
@@ -0,0 +1,69 @@
+#ifndef VITO_AP_COALESCER_H_
+#define VITO_AP_COALESCER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "ara/core/string.h"
+#include "ara/core/vector.h"
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logging_handler.h"
+
+namespace ara::log {
+/// @brief Collapses repeats of a message into one "repeated N times" record per window, in front of the handlers.
+/// Messages are told apart by their content hash (context, level, message id and arguments). The first occurrence is
+/// emitted and opens a window; repeats within it are only counted, and once the window has ended, which is noticed by
+/// the next message, by Sweep() or by Flush(), a record with the arguments of the message and the count is emitted. The
+/// consumer stage calls Sweep() when its windows end, so records go out on time while no other message comes. Tracked
+/// messages, with a copy of their arguments, live in a table of fixed size allocated up front, so coalescing allocates
+/// nothing per message. Not thread safe: it runs on the writer thread of the asynchronous mode, which coalescing
+/// requires.
+class Coalescer {
+ public:
+  /// @param config the window and table size
+  /// @param handlers the handlers to emit to, which must outlive the coalescer
+  Coalescer(const CoalesceConfig& config, const core::Vector<std::unique_ptr<LoggingHandler>>& handlers);
+
+  /// @brief Emit a message to the handlers of its sinks, unless it repeats one emitted within the window.
+  void Emit(const std::shared_ptr<dlt::Message>& message);
+
+  /// @brief Emit the records of all open windows and close them.
+  void Flush();
+
+  /// @brief Close the windows that ended by now, emitting their records.
+  /// @return the end of the earliest window still open, or time_point::max() if there is none
+  std::chrono::steady_clock::time_point Sweep(std::chrono::steady_clock::time_point now);
+
+ private:
+  struct Entry {
+    /// @brief whether a window is open
+    bool active{false};
+    std::uint64_t hash{0};
+    std::chrono::steady_clock::time_point window_end;
+    std::uint64_t repeats{0};
+    LogLevel log_level{LogLevel::kOff};
+    SinkMask sinks{0};
+    /// @brief reserved up front, so that taking over the context id of a message does not allocate
+    core::String ctx_id;
+    /// @brief the arguments of a verbose message, repeated in the record
+    dlt::Payload arguments;
+    /// @brief the descriptor of a modeled message, whose format text stands in for its arguments in the record
+    const detail::ModeledMessageInfo* modeled_info{nullptr};
+  };
+
+  /// @brief Close the window of an entry, emitting its record if the message repeated.
+  void Close(Entry& entry);
+
+  void EmitToSinks(const std::shared_ptr<dlt::Message>& message) const;
+
+ private:
+  const std::chrono::steady_clock::duration window_;
+  const core::Vector<std::unique_ptr<LoggingHandler>>& handlers_;
+  core::Vector<Entry> entries_;
+  std::chrono::steady_clock::time_point next_sweep_;
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_COALESCER_H_
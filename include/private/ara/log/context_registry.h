@@ -0,0 +1,169 @@
+#ifndef VITO_AP_CONTEXT_REGISTRY_H_
+#define VITO_AP_CONTEXT_REGISTRY_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "ara/core/optional.h"
+#include "ara/core/string.h"
+#include "ara/core/string_view.h"
+#include "ara/core/vector.h"
+#include "ara/log/common.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logger.h"
+
+namespace ara::log {
+/// @brief State of a logging context, shared by all copies of its Logger.
+/// The setters derive the enabled levels from several atomics, so they are only called under the registry lock, which
+/// keeps concurrent changes from publishing a stale level; producers read the levels without it.
+struct Logger::Impl {
+  /// @brief sinks taking each level, indexed by LogLevel
+  using LevelSinks = std::array<SinkMask, static_cast<std::size_t>(LogLevel::kVerbose) + 1>;
+
+  /// @brief Set the threshold, and with it the enabled level.
+  void SetThreshold(LogLevel level);
+
+  /// @brief Set the sinks taking each level, and with them the enabled level.
+  void Route(const LevelSinks& level_sinks);
+
+  /// @brief Set the most verbose level captured for the backtrace, and with it the enabled level.
+  void SetBacktraceLevel(LogLevel level);
+
+  /// @brief Return whether a message of log_level goes to the sinks, rather than only to the backtrace.
+  bool Emits(LogLevel log_level) const { return log_level <= emitted_level.load(std::memory_order_relaxed); }
+
+  /// @brief Return the sinks a message of log_level goes to.
+  SinkMask Sinks(LogLevel log_level) const {
+    return sinks[static_cast<std::size_t>(log_level)].load(std::memory_order_relaxed);
+  }
+
+  ContextHandle handle;
+  core::String ctx_id;
+  core::String ctx_desc;
+  std::atomic<LogLevel> threshold;
+  /// @brief whether the threshold was set for this context over the control channel, so that it no longer follows the
+  /// default threshold; guarded by the registry lock
+  bool own_threshold{false};
+  /// @brief compiled from the routing rules when the context is created, or when the rules are set
+  std::array<std::atomic<SinkMask>, std::tuple_size_v<LevelSinks>> sinks{};
+  /// @brief most verbose level some sink takes
+  std::atomic<LogLevel> routed_level{LogLevel::kOff};
+  /// @brief most verbose level captured for the backtrace while below emitted_level
+  std::atomic<LogLevel> backtrace_level{LogLevel::kOff};
+  /// @brief the lesser of threshold and routed_level: the most verbose level going to the sinks
+  std::atomic<LogLevel> emitted_level{LogLevel::kOff};
+  /// @brief the greater of emitted_level and backtrace_level, which Logger::IsEnabled() checks, so that no message is
+  /// built that neither a sink nor the backtrace would take
+  std::atomic<LogLevel> enabled_level{LogLevel::kOff};
+
+ private:
+  /// @brief Recompute emitted_level and enabled_level.
+  void UpdateLevels();
+};
+
+/// @brief Registry of the logging contexts, read from any thread without locks while contexts are rarely added.
+/// Contexts get dense handles in creation order and live, together with their Logger, in chunks that never move, so a
+/// lookup by handle is two array accesses. Lookups by context id probe an open addressing table of handles; a table
+/// getting full is replaced by a larger copy, and the old one is kept since readers may still be probing it. Contexts
+/// are never removed, and only adding one takes a lock.
+class ContextRegistry {
+ public:
+  /// @brief A context as listed to control clients.
+  struct ContextInfo {
+    core::StringView ctx_id;
+    core::StringView ctx_desc;
+    LogLevel threshold;
+  };
+
+  ContextRegistry();
+
+  /// @brief Return the logger of ctx_id, creating the context with ctx_desc and threshold if it does not exist yet.
+  Logger& GetOrCreate(core::StringView ctx_id, core::StringView ctx_desc, LogLevel threshold);
+
+  /// @brief Return the logger of a context, or nullptr if there is no such context.
+  Logger* Find(ContextHandle handle);
+
+  /// @brief Return the logger of a context, or nullptr if there is no such context.
+  Logger* Find(core::StringView ctx_id);
+
+  /// @brief Return the number of contexts, whose handles are 0 to Size() - 1.
+  std::size_t Size() const;
+
+  /// @brief Return the id, description and threshold of a context, or nullopt if there is no such context.
+  core::Optional<ContextInfo> Info(ContextHandle handle);
+
+  /// @brief Set the threshold of a context, which from then on no longer follows the default threshold.
+  /// Producers see the new threshold with their next (relaxed atomic) check.
+  void SetThreshold(ContextHandle handle, LogLevel threshold);
+
+  /// @brief Set the threshold of all contexts without one of their own, and of the contexts created from now on.
+  void SetDefaultThreshold(LogLevel threshold);
+
+  /// @brief Return the default threshold: the one last set, or that of CreateLogger() if none was.
+  LogLevel DefaultThreshold();
+
+  /// @brief Route all contexts, and the contexts created from now on, by the rules in routes.
+  /// Until this is called there are no sinks, and nothing is enabled.
+  /// @param routes the rules, as read from the manifest
+  /// @param sink_count the number of sinks
+  void SetRoutes(const core::Vector<RouteConfig>& routes, std::size_t sink_count);
+
+  /// @brief Set the most verbose level a context captures for the backtrace.
+  void SetBacktraceLevel(ContextHandle handle, LogLevel log_level);
+
+  /// @brief Set the backtrace level of the contexts in config, and of those created from now on.
+  void SetBacktrace(const BacktraceConfig& config);
+
+ private:
+  struct Context {
+    Context(ContextHandle handle, core::StringView ctx_id, core::StringView ctx_desc, LogLevel threshold);
+
+    Logger::Impl impl;
+    Logger logger;
+  };
+
+  /// @brief Table of handle + 1 by the hash of the context id, with 0 marking a free slot; its size is a power of two.
+  using Index = core::Vector<std::atomic<std::uint32_t>>;
+
+  /// @brief chunk i holds kFirstChunkSize << i contexts
+  static constexpr std::size_t kFirstChunkSize{64};
+  static constexpr std::size_t kMaxChunks{32};
+  static constexpr std::size_t kFirstIndexSize{256};
+
+  /// @brief Return the chunk of a handle and its position in the chunk.
+  static std::pair<std::size_t, std::size_t> Locate(ContextHandle handle);
+
+  Context& At(ContextHandle handle);
+
+  /// @brief Add a handle to index, which must have a free slot.
+  void Insert(Index& index, ContextHandle handle);
+
+  /// @brief Compile routes_ for a context.
+  void Route(Logger::Impl& impl) const;
+
+  /// @brief Apply backtrace_ to a context.
+  void ApplyBacktrace(Logger::Impl& impl) const;
+
+ private:
+  std::mutex mutex_;
+  std::array<std::unique_ptr<core::Optional<Context>[]>, kMaxChunks> chunks_;
+  /// @brief number of contexts, published after the context itself
+  std::atomic<std::uint32_t> size_{0};
+  /// @brief the current table, the last of indexes_
+  std::atomic<Index*> index_;
+  /// @brief the current and all replaced tables
+  core::Vector<std::unique_ptr<Index>> indexes_;
+  /// @brief set by SetDefaultThreshold(), overriding the threshold contexts are created with
+  core::Optional<LogLevel> default_threshold_;
+  core::Vector<RouteConfig> routes_;
+  /// @brief all sinks, which without routes_ take every level
+  SinkMask all_sinks_{0};
+  BacktraceConfig backtrace_;
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_CONTEXT_REGISTRY_H_
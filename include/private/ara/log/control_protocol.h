@@ -0,0 +1,77 @@
+#ifndef VITO_AP_CONTROL_PROTOCOL_H_
+#define VITO_AP_CONTROL_PROTOCOL_H_
+
+#include <cstdint>
+
+#include "ara/core/result.h"
+#include "ara/core/span.h"
+#include "ara/core/string.h"
+#include "ara/core/utility.h"
+#include "ara/core/vector.h"
+#include "ara/log/common.h"
+
+/// @brief DLT control messages exchanged over the control channel.
+/// A message is a DLT v2 base header (control content, MSIN request or response, no extension header fields) followed
+/// by the service id and its parameters, all in network byte order. Ids and descriptions are string fields: a length
+/// byte that includes the terminating NUL, the characters and the NUL.
+namespace ara::log::control {
+/// @brief The supported services, numbered like their DLT counterparts.
+enum class ServiceId : std::uint32_t {
+  /// @brief set the threshold of a context, or of all contexts: app id, ctx id and level
+  kSetLogLevel = 0x01,
+  /// @brief list the contexts with their threshold and description: app id and ctx id to filter by
+  kGetLogInfo = 0x03,
+  /// @brief get the threshold of contexts without a level of their own
+  kGetDefaultLogLevel = 0x04,
+  /// @brief set the threshold of contexts without a level of their own, and of later ones: level
+  kSetDefaultLogLevel = 0x11,
+};
+
+enum class Status : std::uint8_t {
+  kOk = 0,
+  kNotSupported = 1,
+  kError = 2,
+};
+
+struct Request {
+  ServiceId service;
+  /// @brief the application addressed, or empty for any
+  core::String app_id;
+  /// @brief the context addressed, or empty for all
+  core::String ctx_id;
+  LogLevel log_level{LogLevel::kOff};
+};
+
+struct ContextInfo {
+  core::String ctx_id;
+  LogLevel log_level;
+  core::String description;
+};
+
+struct Response {
+  ServiceId service;
+  Status status{Status::kOk};
+  /// @brief the default level (kGetDefaultLogLevel)
+  LogLevel log_level{LogLevel::kOff};
+  /// @brief the application and its contexts (kGetLogInfo)
+  core::String app_id;
+  core::Vector<ContextInfo> contexts;
+};
+
+/// @brief Largest control message, bounded by the LEN field; a kGetLogInfo response lists as many contexts as fit.
+inline constexpr std::size_t kMaxMessageSize{0xFFFF};
+
+core::Vector<core::Byte> Serialize(const Request& request);
+
+core::Vector<core::Byte> Serialize(const Response& response);
+
+/// @brief Decode a request; one for an unknown service is returned with the service id only.
+/// @return LogErrc::kInvalidControlMessage if message is not a well-formed control request
+core::Result<Request> ParseRequest(core::Span<const core::Byte> message);
+
+/// @brief Decode a response.
+/// @return LogErrc::kInvalidControlMessage if message is not a well-formed control response
+core::Result<Response> ParseResponse(core::Span<const core::Byte> message);
+}  // namespace ara::log::control
+
+#endif  // !VITO_AP_CONTROL_PROTOCOL_H_
@@ -0,0 +1,35 @@
+#ifndef VITO_AP_CONTROL_SERVER_H_
+#define VITO_AP_CONTROL_SERVER_H_
+
+#include <memory>
+
+#include "ara/core/result.h"
+#include "ara/log/context_registry.h"
+#include "ara/log/log_config.h"
+
+namespace ara::log {
+/// @brief Serves control requests (see control_protocol.h) on a UNIX domain socket, so that thresholds can be changed
+/// while the process runs. Requests are served on a thread of their own and only store the new thresholds in the
+/// context registry, where producers read them with a relaxed atomic load: logging never waits for the channel.
+class ControlServer {
+ public:
+  /// @brief Listen on the socket, replacing a stale one left at its path, and start the control thread.
+  /// @return the server, or LogErrc::kOpenControlChannelFailed if the socket cannot be bound, or if its path is taken by
+  /// anything but a socket left behind by an earlier run
+  static core::Result<std::unique_ptr<ControlServer>> Open(const ControlConfig& config, ContextRegistry& contexts);
+
+  ControlServer(const ControlConfig& config, ContextRegistry& contexts);
+
+  ControlServer(const ControlServer&) = delete;
+  ControlServer& operator=(const ControlServer&) = delete;
+
+  /// @brief Stop the control thread, drop the connected clients and remove the socket.
+  ~ControlServer();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_CONTROL_SERVER_H_
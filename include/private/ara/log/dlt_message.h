@@ -1,27 +1,133 @@
 #ifndef VITO_AP_DLT_MESSAGE_H_
 #define VITO_AP_DLT_MESSAGE_H_
 
-#include <bitset>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstring>
 #include <memory>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 #include "ara/core/optional.h"
+#include "ara/core/result.h"
+#include "ara/core/span.h"
 #include "ara/core/string.h"
 #include "ara/core/string_view.h"
 #include "ara/core/utility.h"
 #include "ara/core/vector.h"
 #include "ara/log/common.h"
+#include "ara/log/log_config.h"
+#include "ara/log/log_stream.h"
+#include "ara/log/log_stream_buffer.h"
+#include "ara/log/modeled_message.h"
+#include "ara/log/object_pool.h"
 
 namespace ara::log::dlt {
-constexpr std::uint8_t kHtyp2Len{32};
+/// @brief Convert a value between host and little endian byte order, the byte order of verbose mode payloads.
+template <typename T>
+T LittleEndian(T value) {
+  if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) {
+    auto bytes = std::bit_cast<std::array<core::Byte, sizeof(T)>>(value);
+    std::reverse(bytes.begin(), bytes.end());
+    return std::bit_cast<T>(bytes);
+  } else {
+    return value;
+  }
+}
+
+/// @brief Sequential writer of a serialized message. Header fields are written in network byte order (big endian).
+class ByteWriter {
+ public:
+  explicit ByteWriter(core::Span<core::Byte> out) : out_{out} {}
+
+  template <typename T>
+  void Write(T value) {
+    static_assert(std::is_unsigned_v<T>, "header fields are unsigned integers");
+    for (std::size_t i{sizeof(T)}; i > 0; --i) {
+      out_[size_++] = static_cast<core::Byte>(value >> ((i - 1) * 8));
+    }
+  }
+
+  /// @brief Write the lower 40 bits of value, the width of the seconds field of a timestamp.
+  void WriteUint40(std::uint64_t value) {
+    Write(static_cast<std::uint8_t>(value >> 32));
+    Write(static_cast<std::uint32_t>(value));
+  }
+
+  void Write(core::Span<const core::Byte> bytes) {
+    std::memcpy(out_.data() + size_, bytes.data(), bytes.size());
+    size_ += bytes.size();
+  }
+
+  /// @brief Return the serialized size of a string field; strings longer than kMaxStringLength are cut.
+  static std::size_t StringSize(core::StringView str) {
+    return sizeof(std::uint8_t) + std::min(str.size(), kMaxStringLength) + 1;
+  }
+
+  /// @brief Write a string field: its length (including the terminating NUL) as one byte, then the string and NUL.
+  void WriteString(core::StringView str) {
+    const auto length = std::min(str.size(), kMaxStringLength);
+    Write(static_cast<std::uint8_t>(length + 1));
+    Write(std::as_bytes(core::Span<const char>{str.data(), length}));
+    Write(std::uint8_t{0});
+  }
+
+  std::size_t Size() const { return size_; }
+
+ private:
+  static constexpr std::size_t kMaxStringLength{254};
+  core::Span<core::Byte> out_;
+  std::size_t size_{0};
+};
+
+/// @brief Sequential reader of a serialized message, the counterpart of ByteWriter.
+class ByteReader {
+ public:
+  explicit ByteReader(core::Span<const core::Byte> in) : in_{in} {}
+
+  /// @brief Read a field written in network byte order, or return nullopt if the input is too short.
+  template <typename T>
+  core::Optional<T> Read() {
+    static_assert(std::is_unsigned_v<T>, "header fields are unsigned integers");
+    if (offset_ + sizeof(T) > in_.size()) {
+      return std::nullopt;
+    }
+    T value{0};
+    for (std::size_t i{0}; i < sizeof(T); ++i) {
+      value = static_cast<T>(value << 8 | std::to_integer<T>(in_[offset_++]));
+    }
+    return value;
+  }
+
+  /// @brief Read a string field as written by ByteWriter::WriteString(), or return nullopt if it is malformed.
+  core::Optional<core::StringView> ReadString() {
+    const auto length = Read<std::uint8_t>();
+    if (!length || *length == 0 || offset_ + *length > in_.size()) {
+      return std::nullopt;
+    }
+    const core::StringView str{reinterpret_cast<const char*>(in_.data() + offset_), *length - 1U};
+    offset_ += *length;
+    return str;
+  }
+
+ private:
+  core::Span<const core::Byte> in_;
+  std::size_t offset_{0};
+};
 
 class HeaderType {
  public:
   static HeaderType VerboseMode();
 
+  /// @brief Header type of control messages, which carry no extension header fields.
+  static HeaderType ControlMode();
+
+  /// @brief Header type of modeled messages: only the message id identifies them, so no extension header fields.
+  static HeaderType NonVerboseMode();
+
   enum class Cnti : std::uint8_t {
     kVerboseModeDataMessage = 0x0,
     kNonVerboseModeDataMessage = 0x1,
@@ -61,15 +167,29 @@ class HeaderType {
 
   bool GetWithSegmentation() const;
 
+  /// @brief Return the packed HTYP2 field.
+  std::uint32_t Value() const;
+
  private:
   HeaderType();
 
+  void SetFlag(std::uint32_t flag, bool with);
+
  private:
-  std::bitset<kHtyp2Len> value_;
+  static constexpr std::uint32_t kCntiMask{0x3U};
+  static constexpr std::uint32_t kWeid{1U << 2};
+  static constexpr std::uint32_t kWacid{1U << 3};
+  static constexpr std::uint32_t kWsid{1U << 4};
+  static constexpr std::uint8_t kVersOffset{5U};
+  static constexpr std::uint32_t kWsfln{1U << 8};
+  static constexpr std::uint32_t kWtgs{1U << 9};
+  static constexpr std::uint32_t kWpvl{1U << 10};
+  static constexpr std::uint32_t kWsgm{1U << 11};
+  std::uint32_t value_{0};
 };
 
-constexpr std::uint8_t kMsinLen{8};
 class MessageInfo {
+ public:
   enum class MessageType : std::uint8_t {
     kLog = 0x0,
     kTrace = 0x1,
@@ -108,40 +228,74 @@ class MessageInfo {
     kResponse = 0x2,
   };
 
- public:
   static MessageInfo LogMessage(LogLevel log_level);
 
   static MessageInfo TraceMessage(TraceMessageInfo trace_info);
 
   static MessageInfo NetworkMessage(NetworkMessageInfo network_info);
 
+  static MessageInfo ControlMessage(ControlMessageInfo control_info);
+
   LogLevel GetLogLevel() const;
 
+  /// @brief Return the packed MSIN field.
+  std::uint8_t Value() const;
+
  private:
   MessageInfo(MessageType message_type, std::uint8_t message_type_info);
 
  private:
-  std::bitset<kMsinLen> value_;
+  static constexpr std::uint8_t kMstpOffset{1U};
+  static constexpr std::uint8_t kMtinOffset{4U};
+  std::uint8_t value_{0};
 };
 
 class Timestamp {
  public:
+  /// @brief size of the TMSP2 field: 30 bit nanoseconds in 4 bytes, followed by 40 bit seconds in 5 bytes
+  static constexpr std::size_t kSerializedSize{9};
+
+  /// @brief Capture the current value of the configured TimeSource; it is converted to wall-clock time when read.
   Timestamp();
 
-  const core::String ToString() const;
+  /// @brief Append the local date and time, with nanoseconds, to out.
+  void FormatTo(core::String& out) const;
+
+  std::uint32_t Nanoseconds() const;
+
+  std::uint64_t Seconds() const;
 
  private:
-  std::uint32_t nanoseconds_;
-  std::uint64_t seconds_;
+  static constexpr std::uint32_t kNanosecondsMask{0x3FFF'FFFFU};
+  static constexpr std::uint64_t kSecondsMask{0xFF'FFFF'FFFFU};
+  /// @brief the raw TimeSource value
+  std::uint64_t raw_;
 };
 
 class BaseHeader {
  public:
   static BaseHeader VerboseModeLogBaseHeader(HeaderType&& header_type, LogLevel log_level);
 
+  static BaseHeader NonVerboseModeLogBaseHeader(HeaderType&& header_type, LogLevel log_level, std::uint32_t message_id);
+
+  static BaseHeader ControlBaseHeader(HeaderType&& header_type, MessageInfo message_info);
+
   LogLevel GetLogLevel() const;
 
-  core::String GetTimeStr() const;
+  /// @brief Append the rendered timestamp, if any, to out.
+  void FormatTimeTo(core::String& out) const;
+
+  HeaderType& GetHeaderType();
+
+  const HeaderType& GetHeaderType() const;
+
+  std::size_t SerializedSize() const;
+
+  /// @brief Write the base header.
+  /// @param writer the destination, with at least SerializedSize() bytes left
+  /// @param length the LEN field, the size of the whole message
+  /// @param number_of_arguments the NOAR field
+  void Serialize(ByteWriter& writer, std::uint16_t length, std::uint8_t number_of_arguments) const;
 
  private:
   explicit BaseHeader(HeaderType&& header_type);
@@ -173,6 +327,24 @@ class ExtensionHeader {
 
   core::StringView CtxId() const;
 
+  void SetSourceLocation(core::StringView file_name, std::uint32_t line_num);
+
+  void ClearSourceLocationAndTags();
+
+  core::StringView FileName() const;
+
+  core::Optional<std::uint32_t> LineNum() const;
+
+  void AddTag(core::StringView tag);
+
+  const core::Vector<core::String>& Tags() const;
+
+  /// @brief Return the size of the fields enabled by header_type.
+  std::size_t SerializedSize(const HeaderType& header_type) const;
+
+  /// @brief Write the fields enabled by header_type.
+  void Serialize(ByteWriter& writer, const HeaderType& header_type) const;
+
  private:
   template <typename DT, typename VT>
   struct Field {
@@ -186,94 +358,168 @@ class ExtensionHeader {
   core::Optional<uint32_t> session_id_;
   Field<uint8_t, core::String> file_name_;
   core::Optional<uint32_t> line_num_;
-  Field<uint8_t, Field<uint8_t, core::String>> tags_;
+  Field<uint8_t, core::Vector<core::String>> tags_;
 };
 
 class Payload {
+ public:
   static constexpr std::uint8_t kTypeBoolOffset{4U};
   static constexpr std::uint8_t kTypeSignedOffset{5U};
   static constexpr std::uint8_t kTypeUnsignedOffset{6U};
   static constexpr std::uint8_t kTypeFloatOffset{7U};
   static constexpr std::uint8_t kTypeStringOffset{9U};
-  class Argument {
-    using ValueType = std::variant<bool, std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, std::int8_t,
-                                   std::int16_t, std::int32_t, std::int64_t, double, float, core::StringView>;
-
-   public:
-    template <typename Ty_>
-    Argument(Ty_ value) {
-      using T = std::decay_t<Ty_>;
-      if constexpr (std::is_same_v<T, bool>) {
-        type_info_ = 1U;
-        type_info_ |= 1U << kTypeBoolOffset;
-        data_payload_.resize(sizeof(T));
-        std::memcpy(data_payload_.data(), &value, sizeof(T));
-      } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
-        if constexpr (std::is_same_v<T, std::int8_t>) {
-          type_info_ = 1U;
-        } else if constexpr (std::is_same_v<T, std::int16_t>) {
-          type_info_ = 2U;
-        } else if constexpr (std::is_same_v<T, std::int32_t>) {
-          type_info_ = 3U;
-        } else if constexpr (std::is_same_v<T, std::int64_t>) {
-          type_info_ = 4U;
-        } else {
-          // TODO support 128bit signed integer
-        }
-        type_info_ |= 1U << kTypeSignedOffset;
-        data_payload_.resize(sizeof(T));
-        std::memcpy(data_payload_.data(), &value, sizeof(T));
-      } else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>) {
-        if constexpr (std::is_same_v<T, std::uint8_t>) {
-          type_info_ = 1U;
-        } else if constexpr (std::is_same_v<T, std::uint16_t>) {
-          type_info_ = 2U;
-        } else if constexpr (std::is_same_v<T, std::uint32_t>) {
-          type_info_ = 3U;
-        } else if constexpr (std::is_same_v<T, std::uint64_t>) {
-          type_info_ = 4U;
-        } else {
-          // TODO support 128bit unsigned integer
-        }
-        type_info_ |= 1U << kTypeUnsignedOffset;
-        data_payload_.resize(sizeof(T));
-        std::memcpy(data_payload_.data(), &value, sizeof(T));
-      } else if constexpr (std::is_floating_point_v<T>) {
-        if constexpr (std::is_same_v<T, float>) {
-          type_info_ = 3U;
-        } else if constexpr (std::is_same_v<T, double>) {
-          type_info_ = 4U;
-        } else {
-          // TODO support long double and half
-        }
-        type_info_ |= 1U << kTypeFloatOffset;
-        data_payload_.resize(sizeof(T));
-        std::memcpy(data_payload_.data(), &value, sizeof(T));
-      } else if constexpr (std::is_same_v<T, const char*>) {
-        type_info_ |= 1U << kTypeStringOffset;
-        data_payload_.resize(strlen(value) + 1);
-        std::memcpy(data_payload_.data(), value, strlen(value));
-      }
-    }
+  static constexpr std::uint8_t kTypeRawOffset{10U};
+  static constexpr std::uint8_t kTypeVariableInfoOffset{11U};
+  static constexpr std::uint8_t kStringCodingOffset{15U};
+  static constexpr std::uint32_t kTypeLengthMask{0xFU};
+  static constexpr std::uint32_t kStringCodingUtf8{1U};
+  /// @brief codings of unsigned integers, to be shown in hexadecimal or binary
+  static constexpr std::uint32_t kStringCodingHex{2U};
+  static constexpr std::uint32_t kStringCodingBin{3U};
+
+  using ValueType = std::variant<bool, std::uint64_t, std::int64_t, double, core::StringView, core::Span<const core::Byte>>;
+
+  /// @brief View of one argument encoded in the payload.
+  struct Argument {
+    /// @brief the type info word
+    std::uint32_t type_info;
+    /// @brief the value bytes, without the length field of strings and raw data
+    core::Span<const core::Byte> data;
+    /// @brief the name and unit, if the type info has the VARI bit
+    core::StringView name;
+    core::StringView unit;
 
     ValueType GetValue() const;
-
-   private:
-    std::uint32_t type_info_{0U};
-    core::Vector<core::Byte> data_payload_;
-    ValueType value_;
   };
 
- public:
+  /// @brief Encode an argument in verbose mode (type info followed by the value) at the end of the payload.
+  /// @param arg the argument value
+  /// @return LogErrc::kBufferOverflow if the argument does not fit, or an earlier one did not; the payload is left
+  /// unchanged in that case
+  template <typename Ty_>
+  core::Result<void> AddArgument(Ty_&& arg) {
+    using T = std::decay_t<Ty_>;
+    if constexpr (std::is_same_v<T, bool>) {
+      return AppendFixed(TypeInfoOf<T>(), static_cast<std::uint8_t>(arg));
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      return AppendFixed(TypeInfoOf<T>(), arg);
+    } else if constexpr (std::is_convertible_v<T, core::StringView>) {
+      const core::StringView value{arg};
+      return AppendVariable(TypeInfoOf<T>(), std::as_bytes(core::Span<const char>{value.data(), value.size()}), true);
+    } else {
+      return AppendVariable(TypeInfoOf<T>(), core::Span<const core::Byte>{arg}, false);
+    }
+  }
+
+  /// @brief Encode an argument with attributes in verbose mode: type info, name and unit (if any) and the value.
+  /// @param arg the argument value
+  /// @param attributes the name and unit, sent with the VARI bit, and the formatting hint, kept for FormatTo()
+  /// @return LogErrc::kBufferOverflow if the argument does not fit, or an earlier one did not
+  template <typename Ty_>
+  core::Result<void> AddArgument(Ty_&& arg, const ArgumentAttributes& attributes) {
+    using T = std::decay_t<Ty_>;
+    if constexpr (std::is_same_v<T, bool>) {
+      const auto value = static_cast<std::uint8_t>(arg);
+      return AppendAttributed(TypeInfoOf<T>(), std::as_bytes(core::Span<const std::uint8_t, 1>{&value, 1}), attributes);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      const auto value = LittleEndian(arg);
+      return AppendAttributed(TypeInfoOf<T>(), std::as_bytes(core::Span<const T, 1>{&value, 1}), attributes);
+    } else if constexpr (std::is_convertible_v<T, core::StringView>) {
+      const core::StringView value{arg};
+      return AppendAttributed(TypeInfoOf<T>(), std::as_bytes(core::Span<const char>{value.data(), value.size()}),
+                              attributes);
+    } else {
+      return AppendAttributed(TypeInfoOf<T>(), core::Span<const core::Byte>{arg}, attributes);
+    }
+  }
+
+  /// @brief Encode an argument of a modeled message in non-verbose mode: the value alone, in little endian byte order,
+  /// with strings and raw data behind their 16 bit length.
+  /// @param type the modeled type of the argument
+  /// @param value the value in host byte order
+  /// @return LogErrc::kBufferOverflow if the argument does not fit, or an earlier one did not
+  core::Result<void> AddModeledArgument(ArgumentType type, core::Span<const core::Byte> value);
+
+  /// @brief Append the arguments of another verbose mode payload.
+  /// @return LogErrc::kBufferOverflow if they do not fit, or an earlier argument did not
+  core::Result<void> AddArguments(const Payload& other);
+
+  /// @brief Replace the arguments by those of another payload, copying only the bytes in use.
+  void Assign(const Payload& other);
+
+  /// @brief Drop all arguments, keeping the buffer for the next message.
+  void Clear();
+
+  std::uint8_t NumberOfArguments() const;
+
+  /// @brief Return the encoded arguments, ready to be sent as verbose mode payload.
+  core::Span<const core::Byte> Data() const;
+
+  /// @brief Decode the argument starting at offset and advance offset past it.
+  /// @param offset byte offset into Data()
+  /// @return the argument, or nullopt at the end of the payload
+  core::Optional<Argument> ReadArgument(std::size_t& offset) const;
+
+  /// @brief Append the arguments as text, each followed by a space, to out.
+  void FormatTo(core::String& out) const;
+
+  /// @brief Append the text of a modeled message, with its placeholders replaced by the arguments, to out.
+  void FormatModeledTo(core::String& out, const detail::ModeledMessageInfo& info) const;
+
+ private:
+  template <typename T>
+  static constexpr std::uint32_t TypeLength() {
+    static_assert(sizeof(T) <= 16 && (sizeof(T) & (sizeof(T) - 1)) == 0, "unsupported argument size");
+    return sizeof(T) == 1 ? 1U : sizeof(T) == 2 ? 2U : sizeof(T) == 4 ? 3U : sizeof(T) == 8 ? 4U : 5U;
+  }
+
   template <typename T>
-  void AddArgument(T&& arg) {
-    arguments_.emplace_back(std::forward<T>(arg));
+  static constexpr std::uint32_t TypeInfoOf() {
+    if constexpr (std::is_same_v<T, bool>) {
+      return TypeLength<std::uint8_t>() | 1U << kTypeBoolOffset;
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+      return TypeLength<T>() | 1U << kTypeSignedOffset;
+    } else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>) {
+      return TypeLength<T>() | 1U << kTypeUnsignedOffset;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      return TypeLength<T>() | 1U << kTypeFloatOffset;
+    } else if constexpr (std::is_convertible_v<T, core::StringView>) {
+      return 1U << kTypeStringOffset | kStringCodingUtf8 << kStringCodingOffset;
+    } else {
+      static_assert(std::is_convertible_v<T, core::Span<const core::Byte>>, "unsupported argument type");
+      return 1U << kTypeRawOffset;
+    }
   }
 
-  core::String ToString() const;
+  template <typename T>
+  core::Result<void> AppendFixed(std::uint32_t type_info, T value) {
+    if (truncated_ || !buffer_.Fits(sizeof type_info + sizeof value)) {
+      return Overflow();
+    }
+    buffer_.Append(LittleEndian(type_info));
+    buffer_.Append(LittleEndian(value));
+    ++number_of_arguments_;
+    return {};
+  }
+
+  core::Result<void> AppendVariable(std::uint32_t type_info, core::Span<const core::Byte> value, bool terminate);
+
+  /// @param value the value bytes, in little endian byte order
+  core::Result<void> AppendAttributed(std::uint32_t type_info, core::Span<const core::Byte> value,
+                                      const ArgumentAttributes& attributes);
+
+  /// @brief Return the verbose mode type info of a modeled argument type, which describes its encoding.
+  static std::uint32_t TypeInfo(ArgumentType type);
+
+  core::Result<void> Overflow();
 
  private:
-  core::Vector<Argument> arguments_;
+  Buffer buffer_;
+  std::uint8_t number_of_arguments_{0};
+  /// @brief index and formatting hint of the arguments added with one other than Fmt::kDefault
+  core::Vector<std::pair<std::uint8_t, Format>> formats_;
+  /// @brief set once an argument did not fit; later arguments are dropped too, so the payload stays in order
+  bool truncated_{false};
 };
 
 class Message {
@@ -282,27 +528,108 @@ class Message {
  public:
   static std::shared_ptr<Message> VerboseModeLogMessage(LogLevel log_level, core::StringView ctx_id);
 
+  /// @brief Create a modeled message; info must outlive it, which holds for the descriptors of ModeledMessage types.
+  static std::shared_ptr<Message> NonVerboseModeLogMessage(const detail::ModeledMessageInfo& info,
+                                                           core::StringView ctx_id);
+
+  /// @brief Create a copy of a message, taken from the thread's MessagePool like a new one.
+  static std::shared_ptr<Message> Copy(const Message& other);
+
   Message(ThisIsPrivateType, BaseHeader&& base_header);
 
+  /// @brief Copy the headers, arguments and sinks of another message, keeping the storage of this one.
+  void Assign(const Message& other);
+
+  template <typename T>
+  core::Result<void> AddArgument(T&& arg) {
+    return payload_->AddArgument(std::forward<T>(arg));
+  }
+
   template <typename T>
-  void AddArgument(T&& arg) {
-    payload_->AddArgument(std::forward<T>(arg));
+  core::Result<void> AddArgument(T&& arg, const ArgumentAttributes& attributes) {
+    return payload_->AddArgument(std::forward<T>(arg), attributes);
+  }
+
+  core::Result<void> AddModeledArgument(ArgumentType type, core::Span<const core::Byte> value) {
+    return payload_->AddModeledArgument(type, value);
   }
 
+  void SetSourceLocation(core::StringView file_name, std::uint32_t line_num);
+
+  void AddTag(core::StringView tag);
+
+  LogLevel GetLogLevel() const;
+
+  /// @brief Append the arguments of a verbose mode payload.
+  core::Result<void> AddArguments(const Payload& arguments) { return payload_->AddArguments(arguments); }
+
+  /// @brief Return the context id, which non-verbose messages keep for rendering only.
+  core::StringView CtxId() const;
+
+  /// @brief Return the arguments, in non-verbose encoding for a modeled message.
+  const Payload& GetPayload() const { return *payload_; }
+
+  /// @brief Return the descriptor of a modeled message, or nullptr for a verbose one.
+  const detail::ModeledMessageInfo* ModeledInfo() const { return modeled_info_; }
+
+  /// @brief Return a hash of the context id, level, message id and arguments, which are the same for repeats of a
+  /// message; timestamps, source locations and tags are left out.
+  std::uint64_t ContentHash() const;
+
+  /// @brief Set the sinks the message goes to, as routed for its context and level.
+  void SetSinks(SinkMask sinks);
+
+  SinkMask Sinks() const;
+
+  /// @brief Render the message as text.
+  /// Producers only capture the timestamp and the binary arguments; the text is rendered on the first call, by the
+  /// first text handler (on the writer thread when logging asynchronously), and shared by all later callers.
+  /// @return the text, valid until the message is recycled
   const core::String& ToString() const;
 
+  std::size_t SerializedSize() const;
+
+  /// @brief Write the message in the binary DLT v2 format: base header, extension header and payload.
+  /// @param out the destination buffer
+  /// @return the number of bytes written, or LogErrc::kBufferOverflow if out (or the 16 bit LEN field) is too small
+  core::Result<std::size_t> SerializeTo(core::Span<core::Byte> out) const;
+
+  /// @brief Return the message in the binary DLT v2 format.
+  /// Like the text, it is serialized on the first call, by the first binary handler, and shared by all later callers,
+  /// so each sink only copies it; the buffer is kept when the message is recycled.
+  /// @return the bytes, valid until the message is recycled, or none if the message exceeds the 16 bit LEN field
+  core::Span<const core::Byte> Serialized() const;
+
  private:
   struct ThisIsPrivateType {};
 
+  /// @brief Take a message from the thread's MessagePool, or allocate one if none is free.
   static std::shared_ptr<Message> Create(BaseHeader&& base_header);
 
+  /// @brief Reset a pooled message for reuse, keeping the storage of its headers, payload and text.
+  void Recycle(BaseHeader&& base_header);
+
+  /// @brief Return the kernel id of the calling thread, read once per thread.
+  static std::int64_t CurrentThreadId();
+
  private:
   BaseHeader base_header_;
   core::Optional<ExtensionHeader> ext_header_;
   core::Optional<Payload> payload_;
-  mutable core::Optional<core::String> text_;
-  thread_local static std::int64_t thread_id_;
+  /// @brief the descriptor of a modeled message, used to render it as text
+  const detail::ModeledMessageInfo* modeled_info_{nullptr};
+  mutable core::String text_;
+  mutable bool has_text_{false};
+  mutable core::Vector<core::Byte> serialized_;
+  mutable bool has_serialized_{false};
+  /// @brief the thread that created the message, which is not the one rendering it when logging asynchronously
+  std::int64_t thread_id_{CurrentThreadId()};
+  SinkMask sinks_{0};
 };
+
+/// @brief Per-thread pool recycling messages, together with their argument and text buffers.
+/// It keeps 64 messages per thread; a thread with more of its messages queued for the writer thread allocates.
+using MessagePool = ObjectPool<Message>;
 }  // namespace ara::log::dlt
 
 #endif
\ No newline at end of file
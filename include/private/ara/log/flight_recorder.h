@@ -0,0 +1,55 @@
+#ifndef VITO_AP_FLIGHT_RECORDER_H_
+#define VITO_AP_FLIGHT_RECORDER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "ara/core/result.h"
+#include "ara/core/span.h"
+#include "ara/core/string_view.h"
+#include "ara/core/utility.h"
+
+namespace ara::log::flight_recorder {
+/// @brief The file starts with a FileHeader, padded to kDataOffset; the rest is the ring of records.
+inline constexpr std::size_t kDataOffset{4096};
+/// @brief records start at multiples of kRecordAlignment
+inline constexpr std::size_t kRecordAlignment{8};
+/// @brief identifies a flight recorder file, "ARAFDR1\0" on little-endian machines
+inline constexpr std::uint64_t kFileMagic{0x0031'5244'4641'5241};
+/// @brief marks a completely written record
+inline constexpr std::uint32_t kRecordMagic{0x5244'4C54};
+
+struct FileHeader {
+  std::uint64_t magic;
+  /// @brief size of the ring
+  std::uint64_t capacity;
+  /// @brief total number of bytes ever reserved in the ring; a record at position p lies at offset p % capacity
+  std::atomic<std::uint64_t> head;
+};
+
+/// @brief Header of a record; the serialized DLT message follows it.
+struct RecordHeader {
+  /// @brief kRecordMagic once the message is complete, stored last
+  std::atomic<std::uint32_t> magic;
+  /// @brief size of the message
+  std::uint32_t size;
+  /// @brief position of the record in the stream of all records ever written
+  std::uint64_t position;
+};
+
+constexpr std::size_t RecordSize(std::size_t message_size) {
+  return (sizeof(RecordHeader) + message_size + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+}
+
+/// @brief Read the messages that survived in a flight recorder file, oldest first.
+/// The head stored in the file is not trusted, as the writer may have died at any point: the ring is scanned for
+/// complete records, which are ordered by their position. Records still being written, and older records partly
+/// overwritten by them, are skipped.
+/// @param path the flight recorder file
+/// @param on_message called with each serialized DLT message
+/// @return LogErrc::kOpenSinkFailed if the file cannot be read or is not a flight recorder file
+core::Result<void> Read(core::StringView path, const std::function<void(core::Span<const core::Byte>)>& on_message);
+}  // namespace ara::log::flight_recorder
+
+#endif  // !VITO_AP_FLIGHT_RECORDER_H_
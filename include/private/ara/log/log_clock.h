@@ -0,0 +1,113 @@
+#ifndef VITO_AP_LOG_CLOCK_H_
+#define VITO_AP_LOG_CLOCK_H_
+
+#include <time.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include "ara/core/singleton_pattern.h"
+#include "ara/log/log_config.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace ara::log {
+/// @brief A clock_gettime() clock in the style of ara::core::SteadyClock.
+/// @tparam kClockId the POSIX clock
+/// @tparam kIsSteady whether the clock never jumps
+template <clockid_t kClockId, bool kIsSteady>
+class PosixClock final {
+ public:
+  using rep = std::int64_t;
+  using period = std::nano;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<PosixClock, duration>;
+
+  static constexpr bool is_steady = kIsSteady;
+
+  static time_point now() noexcept {
+    timespec ts{};
+    clock_gettime(kClockId, &ts);
+    return time_point{duration{ts.tv_sec * rep{1'000'000'000} + ts.tv_nsec}};
+  }
+};
+
+using RealtimeClock = PosixClock<CLOCK_REALTIME, false>;
+/// @brief CLOCK_REALTIME at the resolution of the kernel tick, read without entering the kernel
+using RealtimeCoarseClock = PosixClock<CLOCK_REALTIME_COARSE, false>;
+using MonotonicClock = PosixClock<CLOCK_MONOTONIC, true>;
+/// @brief CLOCK_MONOTONIC at the resolution of the kernel tick, read without entering the kernel
+using MonotonicCoarseClock = PosixClock<CLOCK_MONOTONIC_COARSE, true>;
+
+/// @brief The CPU cycle counter (TSC on x86, CNTVCT_EL0 on AArch64) in the style of ara::core::SteadyClock.
+/// Ticks() reads the raw counter in a few nanoseconds; now() converts it with a calibration made on first use and
+/// anchored to MonotonicClock. On other architectures the counter is MonotonicClock itself.
+class TscClock final {
+ public:
+  using rep = std::int64_t;
+  using period = std::nano;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<TscClock, duration>;
+
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept { return time_point{ToDuration(Ticks())}; }
+
+  static std::uint64_t Ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<std::uint64_t>(MonotonicClock::now().time_since_epoch().count());
+#endif
+  }
+
+  /// @brief Convert a counter value to the time since the MonotonicClock epoch.
+  static duration ToDuration(std::uint64_t ticks) noexcept;
+};
+
+/// @brief The clock DLT timestamps are taken from, as chosen by the "ClockSource" setting.
+/// Producers only capture a raw 64 bit counter with Now(); converting it to wall-clock time is left to whoever renders
+/// or serializes the message. Steady sources are converted with the offset to CLOCK_REALTIME measured at Init(), so
+/// later adjustments of the system time do not show up in their timestamps.
+class TimeSource : public core::Singleton<TimeSource> {
+ public:
+  void Init(ClockSource clock_source);
+
+  std::uint64_t Now() const noexcept {
+    switch (clock_source_) {
+      case ClockSource::kRealtimeCoarse:
+        return Count<RealtimeCoarseClock>();
+      case ClockSource::kMonotonic:
+        return Count<MonotonicClock>();
+      case ClockSource::kMonotonicCoarse:
+        return Count<MonotonicCoarseClock>();
+      case ClockSource::kTsc:
+        return TscClock::Ticks();
+      default:
+        return Count<RealtimeClock>();
+    }
+  }
+
+  /// @brief Convert a value returned by Now() to nanoseconds since the Unix epoch.
+  std::uint64_t ToRealtime(std::uint64_t raw) const noexcept;
+
+ private:
+  template <typename Clock>
+  static std::uint64_t Count() noexcept {
+    return static_cast<std::uint64_t>(Clock::now().time_since_epoch().count());
+  }
+
+ private:
+  ClockSource clock_source_{ClockSource::kRealtime};
+  /// @brief CLOCK_REALTIME minus the steady source, in nanoseconds
+  std::int64_t realtime_offset_{0};
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_LOG_CLOCK_H_
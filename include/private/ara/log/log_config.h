@@ -1,13 +1,186 @@
 #ifndef VITO_AP_LOG_CONFIG_H_
 #define VITO_AP_LOG_CONFIG_H_
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
 #include "ara/core/result.h"
 #include "ara/core/singleton_pattern.h"
 #include "ara/core/string.h"
 #include "ara/core/string_view.h"
 #include "ara/core/vector.h"
+#include "ara/log/common.h"
 
 namespace ara::log {
+/// @brief What a producer does when the asynchronous queue is full.
+enum class OverflowPolicy : std::uint8_t {
+  /// @brief discard the message being logged
+  kDropNewest = 0,
+  /// @brief discard the oldest queued message to make room
+  kDropOldest = 1,
+  /// @brief wait until the writer thread has made room
+  kBlock = 2,
+};
+
+/// @brief The clock DLT timestamps are taken from ("ClockSource" in the manifest).
+enum class ClockSource : std::uint8_t {
+  /// @brief CLOCK_REALTIME
+  kRealtime = 0,
+  /// @brief CLOCK_REALTIME_COARSE
+  kRealtimeCoarse = 1,
+  /// @brief CLOCK_MONOTONIC, converted to wall-clock time when rendered
+  kMonotonic = 2,
+  /// @brief CLOCK_MONOTONIC_COARSE, converted to wall-clock time when rendered
+  kMonotonicCoarse = 3,
+  /// @brief the CPU cycle counter, calibrated at startup and converted to wall-clock time when rendered
+  kTsc = 4,
+};
+
+/// @brief Settings of the asynchronous logging mode ("Async" in the manifest).
+struct AsyncConfig {
+  /// @brief hand messages to a writer thread instead of emitting them on the logging thread
+  bool enabled{false};
+  /// @brief number of queued messages, rounded up to a power of two; the messages a thread has queued beyond the 64 its
+  /// pool recycles (see dlt::MessagePool) are allocated
+  std::size_t queue_capacity{8192};
+  OverflowPolicy overflow_policy{OverflowPolicy::kDropNewest};
+};
+
+/// @brief How the file sink encodes messages.
+enum class FileFormat : std::uint8_t {
+  /// @brief one rendered line per message, as on the console
+  kText = 0,
+  /// @brief binary DLT messages back to back, delimited by their LEN field
+  kDlt = 1,
+};
+
+/// @brief Settings of the "ROTATING_FILE" and "TIMED_ROTATING_FILE" sinks ("Rotation" in the "File" object).
+struct RotationConfig {
+  /// @brief size at which ROTATING_FILE starts a new file
+  /// The size is checked per buffer write (see BaseRotatingHandler::BeforeWrite()), so a segment is cut at a buffer
+  /// boundary and may end up to FileConfig::buffer_size short of max_bytes. It exceeds max_bytes when a single write
+  /// is larger (a buffer_size above max_bytes, or an oversized message), and while its rollover is postponed because
+  /// the next segment is still being opened.
+  std::size_t max_bytes{64 << 20};
+  /// @brief period at which TIMED_ROTATING_FILE starts a new file
+  std::chrono::seconds interval{86400};
+  /// @brief number of archived files kept
+  std::size_t backup_count{5};
+  /// @brief gzip archived files
+  bool compress{false};
+};
+
+/// @brief Settings of the "FILE" sink ("File" in the manifest).
+struct FileConfig {
+  /// @brief the file messages are appended to; defaults to the AppId with a .log or .dlt extension
+  core::String path;
+  FileFormat format{FileFormat::kText};
+  /// @brief size of each of the two output buffers; a full buffer is written with one system call
+  std::size_t buffer_size{1 << 20};
+  /// @brief period of the background flush of partially filled buffers, zero to only flush full buffers
+  std::chrono::milliseconds flush_interval{1000};
+  /// @brief messages of this level or more severe are flushed right away
+  LogLevel flush_level{LogLevel::kError};
+  /// @brief minimum time between two fdatasync calls after a flush, zero to never sync
+  std::chrono::milliseconds sync_interval{0};
+  RotationConfig rotation;
+};
+
+/// @brief Settings of the "FLIGHT_RECORDER" sink ("FlightRecorder" in the manifest).
+struct FlightRecorderConfig {
+  /// @brief the ring file; defaults to the AppId with a .fdr extension
+  core::String path;
+  /// @brief size of the ring, rounded up to whole pages
+  std::size_t size{16 << 20};
+};
+
+/// @brief Transport of the "NETWORK" sink.
+enum class NetworkProtocol : std::uint8_t {
+  /// @brief a stream of binary DLT messages to a TCP server, such as a DLT viewer
+  kTcp = 0,
+  /// @brief binary DLT messages packed into UDP datagrams
+  kUdp = 1,
+};
+
+/// @brief Settings of the "NETWORK" sink ("Network" in the manifest).
+struct NetworkConfig {
+  NetworkProtocol protocol{NetworkProtocol::kTcp};
+  /// @brief host name or address of the receiver
+  core::String host{"127.0.0.1"};
+  std::uint16_t port{3490};
+  /// @brief size of each of the two send buffers; messages arriving while both are full are dropped
+  std::size_t buffer_size{1 << 20};
+  /// @brief largest UDP payload messages are packed into; a larger message is sent in a datagram of its own
+  std::size_t datagram_size{1472};
+  /// @brief period at which partially filled buffers are sent
+  std::chrono::milliseconds flush_interval{100};
+  /// @brief delay between connection attempts
+  std::chrono::milliseconds reconnect_interval{1000};
+};
+
+/// @brief Settings of the control channel ("Control" in the manifest).
+struct ControlConfig {
+  /// @brief serve control requests, such as changing log levels, on a UNIX domain socket
+  bool enabled{false};
+  /// @brief the socket; defaults to the AppId with a .ctl extension
+  core::String path;
+};
+
+/// @brief Settings of rate-limited log statements ("RateLimit" in the manifest).
+struct RateLimitConfig {
+  /// @brief period at which the numbers of suppressed messages are reported, zero to not report them
+  std::chrono::milliseconds summary_interval{10000};
+};
+
+/// @brief Settings of the coalescing of repeated messages ("Coalesce" in the manifest).
+struct CoalesceConfig {
+  /// @brief emit the first occurrence of a message and then, instead of its repeats, one record of how often it
+  /// repeated, per window; requires the asynchronous mode
+  bool enabled{false};
+  /// @brief length of a window, counted from the first occurrence
+  std::chrono::milliseconds window{1000};
+  /// @brief number of distinct messages tracked at once, rounded up to a power of two; a message whose slot is taken
+  /// by another one ends the window of that one early
+  std::size_t capacity{256};
+};
+
+/// @brief Settings of the backtrace mode ("Backtrace" in the manifest).
+/// The ring of captured messages is per thread, not per context: the contexts logging on a thread share it, an Error or
+/// Fatal message of any context dumps what all of them captured on that thread, to the sinks of that message, and depth
+/// counts their messages together.
+struct BacktraceConfig {
+  /// @brief most verbose level captured below the threshold of the contexts, kOff to capture nothing
+  LogLevel level{LogLevel::kOff};
+  /// @brief the contexts captured at level, all of them if empty; Logger::SetBacktraceLevel() sets it for others
+  core::Vector<core::String> contexts;
+  /// @brief number of messages kept per thread, of all contexts together, at most kMaxBacktraceDepth
+  std::size_t depth{64};
+};
+
+/// @brief Largest "Backtrace.Depth" accepted; the ring of each thread holds this many full messages.
+inline constexpr std::size_t kMaxBacktraceDepth{65536};
+
+/// @brief A set of sinks, bit i standing for the sink at position i of "LogSinks".
+using SinkMask = std::uint32_t;
+
+/// @brief Most sinks that can be configured, one bit of a SinkMask each.
+inline constexpr std::size_t kMaxSinks{32};
+
+/// @brief A routing rule ("Routes" in the manifest): messages of a context, up to a level, go to some sinks.
+/// Without rules every sink takes every message that passes the threshold of its context. Once rules are given a sink
+/// only takes the messages some rule sends it, and a context only builds messages of the levels some sink takes. The
+/// most specific rules win: a context named by some rules is routed by those alone, and the rules for all contexts
+/// route the others. Rules of the same context add up.
+struct RouteConfig {
+  /// @brief the context the rule applies to, or empty for all contexts
+  core::String ctx_id;
+  /// @brief the least severe level sent
+  LogLevel level{LogLevel::kVerbose};
+  /// @brief the sinks sent to; by name in the manifest, where no names stands for all sinks
+  SinkMask sinks{0};
+};
+
 class LogConfig : public core::Singleton<LogConfig> {
  public:
   core::Result<void> Init(core::StringView config_path);
@@ -18,10 +191,40 @@ class LogConfig : public core::Singleton<LogConfig> {
 
   const core::String& AppId() const;
 
+  const AsyncConfig& Async() const;
+
+  ClockSource GetClockSource() const;
+
+  const FileConfig& File() const;
+
+  const FlightRecorderConfig& FlightRecorder() const;
+
+  const NetworkConfig& Network() const;
+
+  const ControlConfig& Control() const;
+
+  const core::Vector<RouteConfig>& Routes() const;
+
+  const RateLimitConfig& RateLimit() const;
+
+  const CoalesceConfig& Coalesce() const;
+
+  const BacktraceConfig& Backtrace() const;
+
  private:
   core::String ecu_id_;
   core::Vector<core::String> log_sinks_;
   core::String app_id_;
+  AsyncConfig async_;
+  ClockSource clock_source_{ClockSource::kRealtime};
+  FileConfig file_;
+  FlightRecorderConfig flight_recorder_;
+  NetworkConfig network_;
+  ControlConfig control_;
+  core::Vector<RouteConfig> routes_;
+  RateLimitConfig rate_limit_;
+  CoalesceConfig coalesce_;
+  BacktraceConfig backtrace_;
 };
 }  // namespace ara::log
 
@@ -2,6 +2,7 @@
 #define VITO_AP_LOG_STREAM_BUFFER_H_
 
 #include <cstdint>
+#include <cstring>
 
 #include "ara/core/array.h"
 #include "ara/core/result.h"
@@ -23,6 +24,16 @@ class Buffer {
     return {};
   }
 
+  /// @brief Check whether size more bytes can be appended.
+  bool Fits(std::size_t size) const { return length_ + size <= kMaxBufferSize; }
+
+  /// @brief Return the bytes appended so far.
+  core::Span<const core::Byte> Data() const { return {buffer_.data(), length_}; }
+
+  std::uint16_t Size() const { return length_; }
+
+  void Clear() { length_ = 0; }
+
  private:
   template <typename T>
   bool IsOverflow(T value) {
@@ -1,33 +1,63 @@
 #ifndef VITO_AP_LOGGER_MANAGER_H_
 #define VITO_AP_LOGGER_MANAGER_H_
 
-#include <mutex>
-#include <unordered_map>
-
 #include "ara/core/optional.h"
 #include "ara/core/result.h"
 #include "ara/core/singleton_pattern.h"
 #include "ara/core/string_view.h"
 #include "ara/core/vector.h"
+#include "ara/log/async_dispatcher.h"
+#include "ara/log/coalescer.h"
 #include "ara/log/common.h"
+#include "ara/log/context_registry.h"
+#include "ara/log/control_server.h"
 #include "ara/log/logger.h"
 #include "ara/log/logging_handler.h"
+#include "ara/log/suppression_reporter.h"
 
 namespace ara::log {
 class LoggerManager : public core::Singleton<LoggerManager> {
  public:
   core::Result<void> Init();
 
+  /// @brief Emit the messages still queued for the writer thread and stop it; later messages are emitted directly.
+  /// The last summary of suppressed messages is sent before, and the control channel is closed as well.
+  void Deinit();
+
   Logger& CreateLogger(core::StringView ctx_id, core::StringView ctx_desc, LogLevel threshold);
 
   core::Optional<std::reference_wrapper<Logger>> GetLogger(const Logger::Key& key);
 
+  core::Optional<std::reference_wrapper<Logger>> GetLogger(ContextHandle handle);
+
   const core::Vector<std::unique_ptr<LoggingHandler>>& GetLoggingHandlers();
 
+  SuppressionReporter& GetSuppressionReporter();
+
+  ContextRegistry& GetContexts();
+
+  /// @brief Pass a message to the handlers of its sinks, through the writer thread if the asynchronous mode is enabled.
+  void Handle(std::shared_ptr<dlt::Message> message);
+
+  /// @brief Return the state of the "NETWORK" sink's receiver, or ClientState::kUnknown if there is no such sink.
+  ClientState RemoteClientState() const;
+
+  /// @brief Return the counters of the asynchronous mode, if it is enabled.
+  core::Optional<AsyncDispatcher::Statistics> GetAsyncStatistics() const;
+
  private:
-  std::mutex loggers_mtx_;
-  std::unordered_map<Logger::Key, std::unique_ptr<Logger>> loggers_;
+  ContextRegistry contexts_;
+  /// @brief declared after contexts_, which the control thread changes
+  std::unique_ptr<ControlServer> control_server_;
   core::Vector<std::unique_ptr<LoggingHandler>> logging_handlers_;
+  /// @brief the "NETWORK" sink among logging_handlers_, if configured
+  NetworkHandler* network_handler_{nullptr};
+  /// @brief the coalescer, if enabled; it runs on the writer thread of async_dispatcher_
+  std::unique_ptr<Coalescer> coalescer_;
+  /// @brief declared after logging_handlers_ and coalescer_, so the writer thread is stopped before they are destroyed
+  std::unique_ptr<AsyncDispatcher> async_dispatcher_;
+  /// @brief declared last, so the reporter thread is stopped while the handlers and the writer thread still run
+  SuppressionReporter suppression_reporter_;
 };
 }  // namespace ara::log
 
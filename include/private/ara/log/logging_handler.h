@@ -1,7 +1,24 @@
 #ifndef VITO_AP_LOGGING_HANDLER_
 #define VITO_AP_LOGGING_HANDLER_
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
+#include <mutex>
+#include <thread>
+
+#include "ara/core/optional.h"
+#include "ara/core/result.h"
+#include "ara/core/span.h"
+#include "ara/core/string.h"
+#include "ara/core/utility.h"
+#include "ara/core/vector.h"
+#include "ara/log/flight_recorder.h"
+#include "ara/log/log_config.h"
+#include "ara/log/log_error_domain.h"
 
 namespace ara::log {
 
@@ -21,44 +38,277 @@ class ConsoleHandler final : public LoggingHandler {
   void Emit(std::shared_ptr<dlt::Message> message) override;
 };
 
+/// @brief Appends messages to a file through two large page-aligned buffers.
+/// Messages are copied into the active buffer under a short lock. A flush swaps the buffers under that lock and writes
+/// the full one with a single write(2), and fdatasync per FileConfig::sync_interval, under a separate write lock, so
+/// producers that only copy do not wait for the disk. Buffers are flushed every flush_interval by a background thread,
+/// but also on the emitting thread: by the producer whose message no longer fits, and by every producer of a message of
+/// FileConfig::flush_level or more severe. That producer waits for the write, and producers flushing meanwhile queue
+/// behind it on the write lock.
 class FileHandler : public LoggingHandler {
  public:
-  ~FileHandler() override = default;
+  /// @brief Open (or create) the file in append mode.
+  /// @tparam Handler FileHandler or one of its subclasses
+  /// @return the handler, or LogErrc::kOpenSinkFailed if the file cannot be opened or the buffers cannot be allocated
+  template <typename Handler = FileHandler>
+  static core::Result<std::unique_ptr<FileHandler>> Open(const FileConfig& config) {
+    using R = core::Result<std::unique_ptr<FileHandler>>;
+    const auto fd = OpenFile(config.path);
+    if (fd < 0) {
+      return R::FromError(LogErrc::kOpenSinkFailed);
+    }
+    std::unique_ptr<FileHandler> handler{std::make_unique<Handler>(config, fd)};
+    if (!handler->active_.Allocated() || !handler->spare_.Allocated()) {
+      return R::FromError(LogErrc::kOpenSinkFailed);
+    }
+    return R::FromValue(std::move(handler));
+  }
+
+  FileHandler(const FileConfig& config, int fd);
+
+  FileHandler(const FileHandler&) = delete;
+  FileHandler& operator=(const FileHandler&) = delete;
+
+  /// @brief Flush, stop the background thread and close the file.
+  ~FileHandler() override;
+
   void Emit(std::shared_ptr<dlt::Message> message) override;
+
+  /// @brief Write the buffered messages to the file.
+  void Flush();
+
+  /// @brief Return the number of messages dropped because they cannot be encoded as DLT.
+  std::uint64_t Dropped() const;
+
+ protected:
+  /// @brief Open path for appending.
+  /// @return the file descriptor, or -1 on failure
+  static int OpenFile(const core::String& path);
+
+  /// @brief Called with the file lock held before size bytes are written to the file.
+  virtual void BeforeWrite(std::size_t size);
+
+  /// @brief Direct further writes to fd; must be called from BeforeWrite().
+  /// @return the previous file descriptor, which the caller now owns
+  int ReplaceFile(int fd);
+
+  /// @brief Stop the background flush and flush the buffers.
+  /// Subclasses overriding BeforeWrite() call it from their destructor, so that no flush reaches them half destroyed.
+  void Shutdown();
+
+  const FileConfig& Config() const;
+
+ private:
+  /// @brief Page-aligned byte buffer of fixed capacity.
+  class OutputBuffer {
+   public:
+    /// @brief Allocate the buffer; if that fails, its capacity is zero.
+    explicit OutputBuffer(std::size_t capacity);
+
+    bool Allocated() const;
+
+    /// @brief Return the unused tail of the buffer.
+    core::Span<core::Byte> Tail();
+
+    /// @brief Mark size bytes of Tail() as used.
+    void Commit(std::size_t size);
+
+    core::Span<const core::Byte> Data() const;
+
+    bool Empty() const;
+
+    void Clear();
+
+   private:
+    struct Deleter {
+      void operator()(core::Byte* data) const { std::free(data); }
+    };
+
+    std::unique_ptr<core::Byte[], Deleter> data_;
+    std::size_t capacity_;
+    std::size_t size_{0};
+  };
+
+  /// @brief Encode the message into the tail of the active buffer.
+  /// @return the number of bytes used, or nullopt if the message does not fit
+  core::Optional<std::size_t> Encode(const dlt::Message& message, core::Span<core::Byte> tail) const;
+
+  /// @brief Write a message larger than a buffer directly to the file, or drop it if it cannot be encoded as DLT.
+  void WriteOversized(const dlt::Message& message);
+
+  void WriteAll(core::Span<const core::Byte> data);
+
+  void RunFlusher();
+
+ private:
+  const FileConfig config_;
+  /// @brief guarded by write_mutex_
+  int fd_;
+  /// @brief guards active_
+  std::mutex mutex_;
+  OutputBuffer active_;
+  /// @brief guards spare_ and the file; taken before mutex_, so that buffers are written in the order they filled
+  std::mutex write_mutex_;
+  OutputBuffer spare_;
+  std::chrono::steady_clock::time_point last_sync_;
+  std::mutex flusher_mutex_;
+  std::condition_variable flusher_cv_;
+  bool stopping_{false};
+  std::thread flusher_;
+  std::atomic<std::uint64_t> dropped_{0};
 };
 
-class NetworkHandler : public LoggingHandler {
+/// @brief Keeps the most recent messages, serialized as DLT, in a memory-mapped ring file (a flight recorder).
+/// Appending is a reservation with one CAS on the ring head and plain stores into the shared mapping, without system
+/// calls. The kernel writes the pages back on its own, so the last FlightRecorderConfig::size bytes of messages
+/// survive a crash of the process (not of the system) and are recovered with flight_recorder::Read().
+class FlightRecorderHandler final : public LoggingHandler {
  public:
-  ~NetworkHandler() override = default;
+  /// @brief Map the ring file, creating it if needed; an existing ring of the same size is continued.
+  /// @return the handler, or LogErrc::kOpenSinkFailed if the file cannot be mapped
+  static core::Result<std::unique_ptr<FlightRecorderHandler>> Open(const FlightRecorderConfig& config);
+
+  FlightRecorderHandler(void* mapping, std::size_t mapping_size);
+
+  FlightRecorderHandler(const FlightRecorderHandler&) = delete;
+  FlightRecorderHandler& operator=(const FlightRecorderHandler&) = delete;
+
+  ~FlightRecorderHandler() override;
+
   void Emit(std::shared_ptr<dlt::Message> message) override;
+
+ private:
+  void* mapping_;
+  std::size_t mapping_size_;
+  flight_recorder::FileHeader* header_;
+  core::Byte* data_;
+  std::size_t capacity_;
 };
 
-class BaseRotatingHandler : public FileHandler {
+/// @brief Sends binary DLT messages to a remote receiver over TCP or UDP.
+/// Messages are serialized into the active of two send buffers under a short lock. A network thread swaps the
+/// buffers and sends the full one: over TCP with one write, over UDP as datagrams packed with as many messages as fit
+/// in NetworkConfig::datagram_size and passed to the kernel in batches with sendmmsg(2). Buffers are sent when half
+/// full and every flush_interval. Connecting and reconnecting also happen on the network thread, so emitting never
+/// waits for the network: while the receiver is unreachable messages are buffered, and dropped once the buffer is full.
+class NetworkHandler final : public LoggingHandler {
  public:
-  ~BaseRotatingHandler() override = default;
+  /// @brief Start the network thread, which connects to the receiver in the background.
+  /// @return the handler, or LogErrc::kOpenSinkFailed if the host cannot be resolved
+  static core::Result<std::unique_ptr<NetworkHandler>> Open(const NetworkConfig& config);
+
+  explicit NetworkHandler(const NetworkConfig& config);
+
+  NetworkHandler(const NetworkHandler&) = delete;
+  NetworkHandler& operator=(const NetworkHandler&) = delete;
+
+  /// @brief Send the buffered messages, waiting a bounded time for the receiver, and stop the network thread.
+  ~NetworkHandler() override;
+
   void Emit(std::shared_ptr<dlt::Message> message) override;
 
+  /// @brief Return whether the receiver is connected, or ClientState::kUnknown before the first connection attempt has
+  /// completed. Over UDP the receiver counts as connected once datagrams were sent, until the kernel reports it
+  /// unreachable.
+  ClientState GetClientState() const;
+
+  /// @brief Return the number of messages dropped because both buffers were full.
+  std::uint64_t Dropped() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// @brief FileHandler that moves on to a new file (segment) when the current one is complete.
+/// The check runs once per buffer write and is O(1). Rolling over only swaps in a file descriptor that a background
+/// worker opened in advance (at "<path>.next"). The worker then does all the filesystem work: it archives the closed
+/// segment, renames the new one to path, compresses the archive and opens the next segment. If the next segment is
+/// not open yet, the rollover is postponed to a later write instead of waiting for it.
+class BaseRotatingHandler : public FileHandler {
+ public:
+  BaseRotatingHandler(const FileConfig& config, int fd);
+
+  ~BaseRotatingHandler() override;
+
  protected:
-  virtual bool ShouldRollover() = 0;
+  /// @brief Called with the file lock held before size bytes are written to the current segment.
+  virtual bool ShouldRollover(std::size_t size) = 0;
+
+  /// @brief Called with the file lock held to switch segments, typically through SwitchSegment().
   virtual void DoRollover() = 0;
+
+  /// @brief Called on the worker thread to move the closed segment away from the configured path and to delete
+  /// archives beyond RotationConfig::backup_count.
+  /// @param segment_start_time when the closed segment was started
+  /// @return the archived file, or an empty string if it was deleted
+  virtual core::String Archive(std::chrono::system_clock::time_point segment_start_time) = 0;
+
+  /// @brief Swap in the pre-opened next segment and queue the archiving of the current one.
+  /// @return false if the next segment is not open yet
+  bool SwitchSegment();
+
+  /// @brief Return the number of bytes written to the current segment.
+  std::size_t SegmentSize() const;
+
+  /// @brief Flush the buffers and finish the pending background work.
+  /// Subclasses call it from their destructor, as both the flush and the work call back into them.
+  void Shutdown();
+
+ private:
+  void BeforeWrite(std::size_t size) override;
+
+  void RunWorker();
+
+  void OpenNextSegment();
+
+  void Compress(const core::String& file_name) const;
+
+ private:
+  const core::String next_path_;
+  std::atomic<int> next_fd_{-1};
+  std::size_t segment_size_;
+  std::chrono::system_clock::time_point segment_start_time_;
+  std::mutex worker_mutex_;
+  std::condition_variable worker_cv_;
+  /// @brief closed segments waiting to be archived, with their start times
+  core::Vector<std::pair<int, std::chrono::system_clock::time_point>> closed_segments_;
+  bool stopping_{false};
+  std::thread worker_;
 };
 
+/// @brief Rolls over before a segment would exceed RotationConfig::max_bytes. Archives are named path.1 (the newest)
+/// to path.<backup_count>, with a .gz suffix when compressed.
 class RotatingFileHandler final : public BaseRotatingHandler {
  public:
-  ~RotatingFileHandler() override = default;
+  using BaseRotatingHandler::BaseRotatingHandler;
+
+  ~RotatingFileHandler() override;
 
  protected:
-  bool ShouldRollover() override;
+  bool ShouldRollover(std::size_t size) override;
   void DoRollover() override;
+  core::String Archive(std::chrono::system_clock::time_point segment_start_time) override;
 };
 
+/// @brief Rolls over every RotationConfig::interval, at multiples of it since the Unix epoch. Archives are named
+/// path.<local start time of the segment>, with a .gz suffix when compressed.
 class TimedRotatingFileHandler final : public BaseRotatingHandler {
  public:
-  ~TimedRotatingFileHandler() override = default;
+  TimedRotatingFileHandler(const FileConfig& config, int fd);
+
+  ~TimedRotatingFileHandler() override;
 
  protected:
-  bool ShouldRollover() override;
+  bool ShouldRollover(std::size_t size) override;
   void DoRollover() override;
+  core::String Archive(std::chrono::system_clock::time_point segment_start_time) override;
+
+ private:
+  std::chrono::system_clock::time_point NextDeadline() const;
+
+ private:
+  std::chrono::system_clock::time_point deadline_;
 };
 }  // namespace ara::log
 
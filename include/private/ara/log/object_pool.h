@@ -0,0 +1,66 @@
+#ifndef VITO_AP_OBJECT_POOL_H_
+#define VITO_AP_OBJECT_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "ara/core/array.h"
+
+namespace ara::log {
+/// @brief Per-thread pool of recycled objects handed out as std::shared_ptr.
+/// The pool keeps a reference to every object it hands out. Once all other owners have dropped theirs, the pool holds
+/// the last reference and the object is handed out again, with all the storage it has grown, instead of being freed.
+/// An object released on another thread is recycled the same way, and an object still in use when its thread exits
+/// simply outlives the pool. Resetting a recycled object is up to the caller.
+/// The pool is bounded: while a thread holds more than kCapacity objects at once, say messages waiting in the queue of
+/// the asynchronous mode, Acquire() finds none free and every further object is allocated, and freed when released.
+/// @tparam T the pooled type
+/// @tparam kCapacity the number of objects kept per thread
+template <typename T, std::size_t kCapacity = 64>
+class ObjectPool {
+ public:
+  /// @brief Return the pool of the calling thread.
+  static ObjectPool& Local() {
+    thread_local ObjectPool pool;
+    return pool;
+  }
+
+  /// @brief Return an object that is no longer referenced outside the pool.
+  /// @return the object, or nullptr if the probed objects are all still in use
+  std::shared_ptr<T> Acquire() {
+    for (std::size_t probe{0}; probe < kProbeLength && probe < size_; ++probe) {
+      const auto index = (cursor_ + probe) % size_;
+      if (slots_[index].use_count() == 1) {
+        // pairs with the release decrement of the thread that dropped the last outside reference
+        std::atomic_thread_fence(std::memory_order_acquire);
+        cursor_ = (index + 1) % size_;
+        return slots_[index];
+      }
+    }
+    return nullptr;
+  }
+
+  /// @brief Hand a newly allocated object to the pool, so that it is recycled once released.
+  /// The object is not retained (and is freed when released) if the pool is full.
+  /// @param object the object
+  void Adopt(const std::shared_ptr<T>& object) {
+    if (size_ < kCapacity) {
+      slots_[size_++] = object;
+    }
+  }
+
+ private:
+  ObjectPool() = default;
+
+ private:
+  /// @brief number of slots probed by Acquire(); objects are mostly released in order, so few are needed
+  static constexpr std::size_t kProbeLength{4};
+  /// @brief the first size_ slots are in use, so the pool only grows as far as objects are held concurrently
+  core::Array<std::shared_ptr<T>, kCapacity> slots_{};
+  std::size_t size_{0};
+  std::size_t cursor_{0};
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_OBJECT_POOL_H_
@@ -0,0 +1,110 @@
+#ifndef VITO_AP_RING_QUEUE_H_
+#define VITO_AP_RING_QUEUE_H_
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace ara::log {
+/// @brief Bounded lock-free queue after Dmitry Vyukov's MPMC ring.
+/// Every cell carries a sequence number telling whether it is free for the producer of a given position or filled for
+/// its consumer, so pushing and popping each cost one CAS on a position counter and no locks. Any number of threads
+/// may push and pop concurrently.
+/// @tparam T the element type
+template <typename T>
+class RingQueue {
+ public:
+  /// @brief Construct an empty queue.
+  /// @param capacity the number of elements the queue holds, rounded up to a power of two
+  explicit RingQueue(std::size_t capacity)
+      : mask_{std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1}, cells_{new Cell[mask_ + 1]} {
+    for (std::size_t i{0}; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  RingQueue(const RingQueue&) = delete;
+  RingQueue& operator=(const RingQueue&) = delete;
+
+  /// @brief Append an element.
+  /// @param value the element, which is left untouched if the queue is full
+  /// @return false if the queue is full
+  bool TryPush(T&& value) {
+    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& cell = cells_[pos & mask_];
+      const auto diff = Distance(cell.sequence.load(std::memory_order_acquire), pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// @brief Remove the oldest element.
+  /// @param value receives the element
+  /// @return false if the queue is empty
+  bool TryPop(T& value) {
+    auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& cell = cells_[pos & mask_];
+      const auto diff = Distance(cell.sequence.load(std::memory_order_acquire), pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          value = std::move(cell.value);
+          cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// @brief Return whether the next TryPop() would fail, unless an element is pushed in between.
+  bool Empty() const {
+    const auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    return Distance(cells_[pos & mask_].sequence.load(std::memory_order_acquire), pos + 1) < 0;
+  }
+
+  /// @brief Return whether the next TryPush() would fail, unless an element is popped in between.
+  bool Full() const {
+    const auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+    return Distance(cells_[pos & mask_].sequence.load(std::memory_order_acquire), pos) < 0;
+  }
+
+  std::size_t Capacity() const { return mask_ + 1; }
+
+ private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  static std::intptr_t Distance(std::size_t sequence, std::size_t pos) {
+    return static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+  }
+
+ private:
+  static constexpr std::size_t kCacheLineSize{64};
+  const std::size_t mask_;
+  const std::unique_ptr<Cell[]> cells_;
+  /// @brief producers and the consumer each own a cache line, so they do not invalidate each other's position
+  alignas(kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{0};
+  alignas(kCacheLineSize) std::atomic<std::size_t> dequeue_pos_{0};
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_RING_QUEUE_H_
@@ -0,0 +1,48 @@
+#ifndef VITO_AP_SUPPRESSION_REPORTER_H_
+#define VITO_AP_SUPPRESSION_REPORTER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "ara/core/vector.h"
+#include "ara/log/log_limit.h"
+
+namespace ara::log {
+/// @brief Reports how many messages the rate limits suppressed, with one summary message per limit and period.
+/// A limit registers itself when it first suppresses a message; limits are statics, so they are never removed.
+class SuppressionReporter {
+ public:
+  SuppressionReporter() = default;
+
+  SuppressionReporter(const SuppressionReporter&) = delete;
+  SuppressionReporter& operator=(const SuppressionReporter&) = delete;
+
+  ~SuppressionReporter();
+
+  /// @brief Include a limit in the summaries.
+  void Add(LogLimit& limit);
+
+  /// @brief Start the reporter thread, which sends the summaries once per interval.
+  void Start(std::chrono::milliseconds interval);
+
+  /// @brief Send the summaries of what was suppressed since the last ones and stop the reporter thread. Calling it
+  /// again, or without Start(), has no effect.
+  void Stop();
+
+ private:
+  void Run(std::chrono::milliseconds interval);
+
+  void Report();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_{false};
+  core::Vector<LogLimit*> limits_;
+  std::thread reporter_;
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_SUPPRESSION_REPORTER_H_
@@ -29,7 +29,7 @@ class Result final {
 
   /// @brief Construct a new Result from the specified value (given as rvalue).
   /// @param t the value to put into the Result
-  Result(T&& t) : data_{t} {}
+  Result(T&& t) : data_{std::move(t)} {}
 
   /// @brief Construct a new Result from the specified error (given as lvalue).
   /// @param e the error to put into the Result
@@ -61,7 +61,7 @@ class Result final {
   /// @brief Build a new Result from the specified value (given as rvalue).
   /// @param t the value to put into the Result
   /// @return a Result that contains the value t
-  static Result FromValue(T&& t) { return Result{t}; }
+  static Result FromValue(T&& t) { return Result{std::move(t)}; }
 
   /// @brief Build a new Result from a value that is constructed in-place from the given arguments.
   /// This function shall not participate in overload resolution unless : std::is_constructible<T, Args&&...>::value is
@@ -31,6 +31,54 @@ enum class ClientState : std::int8_t {
   /// @brief Remote client is connected.
   kConnected,
 };
+
+/// @brief Dense index of a logging context, assigned in creation order.
+using ContextHandle = std::uint32_t;
+
+/// @brief Format specifiers for log message arguments.
+enum class Fmt : std::uint16_t {
+  /// @brief implementation-defined formatting
+  kDefault = 0,
+  /// @brief decimal(signed/unsigned)
+  kDec = 1,
+  /// @brief octal
+  kOct = 2,
+  /// @brief hexadecimal
+  kHex = 3,
+  /// @brief binary
+  kBin = 4,
+  /// @brief decimal float(like printf "%f")
+  kDecFloat = 5,
+  /// @brief engineering float(like printf "%e")
+  kEngFloat = 6,
+  /// @brief hex float(like printf "%a")
+  kHexFloat = 7,
+  /// @brief automatic "shortest" float(like printf "%g")
+  kAutoFloat = 8,
+};
+
+/// @brief A type holding a formatting hint.
+/// The interpretation of precision depends on fmt:
+/// For integral types(i.e.Fmt::kDec, Fmt::kOct, Fmt::kHex, Fmt::kBin), precision is interpreted as the minimum number
+/// of digits to output, similar to e.g.std::printf("%.7d").
+/// For the floating - point specifiers Fmt::kDecFloat, Fmt::kEngFloat and Fmt::kHexFloat, precision denotes the exact
+/// number of digits to be shown after the decimal point; for Fmt::kAutoFloat, precision denotes the number of
+/// significant digits to be shown according to the rules of the std::printf "%g" specifier.
+/// If fmt is Fmt::kDefault, the precision field is ignored, and an implementation-defined formatting is applied.For
+/// integral types, if precision is 0, it is interpreted the same as if it was 1.
+struct Format {
+  /// @brief the format specifier
+  Fmt fmt;
+  /// @brief the precision to use
+  std::uint16_t precision;
+};
+
+namespace detail {
+/// @brief precision of the integral formats created without one: as many digits as the value needs
+inline constexpr std::uint16_t kDefaultIntPrecision{1};
+/// @brief precision of the *FloatMax() formats, rendered with the fewest digits that still round-trip
+inline constexpr std::uint16_t kMaxFloatPrecision{UINT16_MAX};
+}  // namespace detail
 }  // namespace ara::log
 
 #endif  // !VITO_AP_COMMON_H_
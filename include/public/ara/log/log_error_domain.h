@@ -13,6 +13,9 @@ enum class LogErrc : std::uint8_t {
   kLoggerNotFound = 1,
   kInvalidConfig = 2,
   kInvalidLogSink = 3,
+  kOpenSinkFailed = 4,
+  kInvalidControlMessage = 5,
+  kOpenControlChannelFailed = 6,
 };
 
 class LogException : public core::Exception {
@@ -0,0 +1,124 @@
+#ifndef VITO_AP_LOG_LIMIT_H_
+#define VITO_AP_LOG_LIMIT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <source_location>
+
+#include "ara/log/common.h"
+
+namespace ara::log {
+class SuppressionReporter;
+
+/// @brief Limits how often a log statement is emitted, for statements in loops that would otherwise flood the sinks.
+/// Declare one as a static at the call site and log through Logger::WithLimit():
+/// @code
+/// static ara::log::LogLimit limit{ara::log::LogLimit::TokenBucket(10)};
+/// logger.WithLimit(ara::log::LogLevel::kWarn, limit) << "deadline missed by" << lateness;
+/// @endcode
+/// The limit is constant-initialized, so the static costs no initialization guard, and checking it is an atomic
+/// operation or two, done before any LogStream is built. The number of suppressed messages is reported in a summary
+/// message of the same context and level, tagged with the location of the limit, once per "RateLimit.SummaryIntervalMs"
+/// of the manifest.
+class LogLimit {
+ public:
+  /// @brief Emit up to rate messages per second on average, and up to burst of them at once.
+  /// @param rate messages per second; rates below one message per hour, including zero, negative rates and NaN, are
+  /// raised to one message per hour
+  /// @param burst messages that may be emitted back to back after a quiet period, at least one
+  static constexpr LogLimit TokenBucket(double rate, std::uint32_t burst = 1,
+                                        std::source_location location = std::source_location::current()) noexcept {
+    // written so that NaN takes the clamped branch too
+    const auto interval = rate > kMinRate ? static_cast<std::uint64_t>(kNanosecondsPerSecond / rate) : kMaxInterval;
+    const std::uint64_t extra_tokens{burst > 0 ? burst - 1 : 0};
+    const auto tolerance = interval > 0 && extra_tokens > kMaxTolerance / interval ? kMaxTolerance
+                                                                                   : interval * extra_tokens;
+    return LogLimit{Kind::kTokenBucket, burst, interval, tolerance, location};
+  }
+
+  /// @brief Emit the first message and every n-th one after it.
+  static constexpr LogLimit EveryN(std::uint32_t n,
+                                   std::source_location location = std::source_location::current()) noexcept {
+    return LogLimit{Kind::kEveryN, n > 0 ? n : 1, 0, 0, location};
+  }
+
+  /// @brief Emit the first n messages and suppress all later ones.
+  static constexpr LogLimit FirstN(std::uint32_t n,
+                                   std::source_location location = std::source_location::current()) noexcept {
+    return LogLimit{Kind::kFirstN, n, 0, 0, location};
+  }
+
+  LogLimit(const LogLimit&) = delete;
+  LogLimit& operator=(const LogLimit&) = delete;
+
+  /// @brief Take the decision for one message.
+  /// @return true if the message is to be emitted
+  bool Allow() noexcept {
+    switch (kind_) {
+      case Kind::kEveryN:
+        return state_.fetch_add(1, std::memory_order_relaxed) % n_ == 0;
+      case Kind::kFirstN:
+        // stop writing the counter once it is exhausted, so suppressing costs a shared load
+        return state_.load(std::memory_order_relaxed) < n_ && state_.fetch_add(1, std::memory_order_relaxed) < n_;
+      case Kind::kTokenBucket:
+      default:
+        return TakeToken();
+    }
+  }
+
+  /// @brief Count a suppressed message of a context and level, the first of which registers the limit for summaries.
+  void Suppress(ContextHandle handle, LogLevel log_level) noexcept {
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    if (!registered_.load(std::memory_order_relaxed)) {
+      Register(handle, log_level);
+    }
+  }
+
+ private:
+  friend class SuppressionReporter;
+
+  enum class Kind : std::uint8_t {
+    kTokenBucket,
+    kEveryN,
+    kFirstN,
+  };
+
+  static constexpr double kNanosecondsPerSecond{1e9};
+  /// @brief lowest rate of TokenBucket(), one message per hour
+  static constexpr double kMinRate{1.0 / 3600};
+  static constexpr std::uint64_t kMaxInterval{3600'000'000'000};
+  /// @brief bound of the burst tolerance, far enough from the range of std::uint64_t that adding it to the steady clock
+  /// cannot overflow
+  static constexpr std::uint64_t kMaxTolerance{std::uint64_t{1} << 62};
+
+  constexpr LogLimit(Kind kind, std::uint32_t n, std::uint64_t interval, std::uint64_t tolerance,
+                     std::source_location location) noexcept
+      : kind_{kind}, n_{n}, interval_{interval}, tolerance_{tolerance}, location_{location} {}
+
+  /// @brief Token bucket as a generic cell rate algorithm: state_ is the time, in nanoseconds of the steady clock, at
+  /// which the bucket will be full again.
+  bool TakeToken() noexcept;
+
+  void Register(ContextHandle handle, LogLevel log_level) noexcept;
+
+ private:
+  const Kind kind_;
+  /// @brief n of EveryN() and FirstN(), burst of TokenBucket()
+  const std::uint32_t n_;
+  /// @brief nanoseconds per token
+  const std::uint64_t interval_;
+  /// @brief how far the refill time may run ahead of now, which allows bursts
+  const std::uint64_t tolerance_;
+  const std::source_location location_;
+  /// @brief message counter, or the refill time of the token bucket
+  std::atomic<std::uint64_t> state_{0};
+  /// @brief suppressed messages not reported yet
+  std::atomic<std::uint64_t> suppressed_{0};
+  std::atomic<bool> registered_{false};
+  /// @brief context and level of the summaries, set when registered
+  ContextHandle handle_{0};
+  LogLevel log_level_{LogLevel::kOff};
+};
+}  // namespace ara::log
+
+#endif  // !VITO_AP_LOG_LIMIT_H_
@@ -3,6 +3,7 @@
 
 #include <chrono>
 #include <memory>
+#include <type_traits>
 
 #include "ara/core/error_code.h"
 #include "ara/core/instance_specifier.h"
@@ -14,10 +15,66 @@
 namespace ara::log {
 class Logger;
 
+/// @brief Attributes of a payload argument, see Arg().
+struct ArgumentAttributes {
+  /// @brief the name of the argument, or nullptr
+  const char* name;
+  /// @brief the unit of the argument, or nullptr
+  const char* unit;
+  /// @brief the formatting hint
+  Format format;
+};
+
+namespace detail {
+template <typename U, typename Signed, typename Unsigned>
+using SignednessOf = std::conditional_t<std::is_signed_v<U>, Signed, Unsigned>;
+
+/// @brief Return the LogStream operand type an argument of type T is logged as, wrapped in std::type_identity.
+template <typename T>
+constexpr auto ArgumentValueTypeOf() {
+  using U = std::remove_cvref_t<T>;
+  if constexpr (std::is_same_v<U, bool>) {
+    return std::type_identity<bool>{};
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 1) {
+    return std::type_identity<SignednessOf<U, std::int8_t, std::uint8_t>>{};
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 2) {
+    return std::type_identity<SignednessOf<U, std::int16_t, std::uint16_t>>{};
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 4) {
+    return std::type_identity<SignednessOf<U, std::int32_t, std::uint32_t>>{};
+  } else if constexpr (std::is_integral_v<U>) {
+    static_assert(sizeof(U) == 8, "unsupported argument type");
+    return std::type_identity<SignednessOf<U, std::int64_t, std::uint64_t>>{};
+  } else if constexpr (std::is_floating_point_v<U>) {
+    static_assert(sizeof(U) <= sizeof(double), "unsupported argument type");
+    return std::type_identity<std::conditional_t<sizeof(U) == sizeof(float), float, double>>{};
+  } else if constexpr (std::is_convertible_v<T, core::StringView>) {
+    return std::type_identity<core::StringView>{};
+  } else {
+    static_assert(std::is_convertible_v<T, core::Span<const core::Byte>>, "unsupported argument type");
+    return std::type_identity<core::Span<const core::Byte>>{};
+  }
+}
+}  // namespace detail
+
 /// @brief Wrapper type for holding a payload argument with its attributes.
-/// The setup of this class is implementation-defined.
+/// It holds the value (strings and byte sequences as views) and pointers to the name and unit, which are meant to be
+/// string literals, so neither creating nor logging an Argument copies any text before it is encoded.
 template <typename T>
-class Argument {};
+class Argument {
+ public:
+  using ValueType = typename decltype(detail::ArgumentValueTypeOf<T>())::type;
+
+  constexpr Argument(ValueType value, const char* name, const char* unit, Format format) noexcept
+      : value_{value}, attributes_{name, unit, format} {}
+
+  constexpr ValueType Value() const noexcept { return value_; }
+
+  constexpr const ArgumentAttributes& Attributes() const noexcept { return attributes_; }
+
+ private:
+  ValueType value_;
+  ArgumentAttributes attributes_;
+};
 
 class LogStream final {
  public:
@@ -99,6 +156,16 @@ class LogStream final {
   /// @return *this
   LogStream& operator<<(core::Span<const core::Byte> data) noexcept;
 
+  /// @brief Writes a payload argument together with its attributes into message.
+  /// The name and unit are sent along with the value (the VARI type info bit); a hexadecimal or binary format of an
+  /// unsigned integer is sent as its coding, all formats are applied when the message is rendered as text.
+  /// @param arg the argument, as created by Arg()
+  /// @return *this
+  template <typename T>
+  LogStream& operator<<(const Argument<T>& arg) noexcept {
+    return AddArgument(arg.Value(), arg.Attributes());
+  }
+
   /// @brief Set the message's privacy level.
   /// A program that calls this function with a T that is neither an integral nor an enum type is ill-formed. Only the
   /// lower 8 bits of value are used , any higher-level bits are ignored.
@@ -119,8 +186,17 @@ class LogStream final {
   LogStream& WithTag(core::StringView tag) noexcept;
 
  private:
+  friend class Logger;
+
+  /// @brief Create an inert stream, as for a filtered level.
+  LogStream() noexcept = default;
+
   bool Enabled() const;
 
+  /// @brief Append an argument with attributes; instantiated for each ValueType of Argument.
+  template <typename T>
+  LogStream& AddArgument(T value, const ArgumentAttributes& attributes) noexcept;
+
  private:
   struct Impl;
   std::shared_ptr<Impl> impl_;
@@ -132,6 +208,29 @@ LogStream& LogStream::WithPrivacy(T value) noexcept {
   return *this;
 }
 
+/// @brief Stand-in for LogStream at log levels that are removed at compile time (see kCompileLevel).
+/// Every operation is an empty inline function, so the whole log statement compiles to nothing. Arguments without side
+/// effects are discarded by the optimizer; arguments with side effects are still evaluated as the language requires,
+/// use Logger::IsEnabled() to guard those.
+class NullLogStream final {
+ public:
+  constexpr void Flush() noexcept {}
+
+  template <typename T>
+  constexpr NullLogStream& operator<<(const T&) noexcept {
+    return *this;
+  }
+
+  template <typename T>
+  constexpr NullLogStream& WithPrivacy(T) noexcept {
+    return *this;
+  }
+
+  constexpr NullLogStream& WithLocation(core::StringView, int) noexcept { return *this; }
+
+  constexpr NullLogStream& WithTag(core::StringView) noexcept { return *this; }
+};
+
 /// @brief Appends LogLevel enum parameter as text into message.
 /// @param out LogStream Object which is used to append the logged LogLevel(value) to
 /// @param value LogLevel enum parameter as text to be appended to the internal message buffer
@@ -1,10 +1,19 @@
 #ifndef VITO_AP_LOGGER_H_
 #define VITO_AP_LOGGER_H_
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <type_traits>
 
 #include "ara/core/string.h"
+#include "ara/log/log_limit.h"
 #include "ara/log/log_stream.h"
+#include "ara/log/modeled_message.h"
+
+#ifndef VITO_AP_LOG_COMPILE_LEVEL
+#define VITO_AP_LOG_COMPILE_LEVEL 0x06
+#endif
 
 namespace ara::log {
 
@@ -12,123 +21,93 @@ namespace dlt {
 class Message;
 }
 
-/// @brief Format specifiers for log message arguments.
-enum class Fmt : std::uint16_t {
-  /// @brief implementation-defined formatting
-  kDefault = 0,
-  /// @brief decimal(signed/unsigned)
-  kDec = 1,
-  /// @brief octal
-  kOct = 2,
-  /// @brief hexadecimal
-  kHex = 3,
-  /// @brief binary
-  kBin = 4,
-  /// @brief decimal float(like printf "%f")
-  kDecFloat = 5,
-  /// @brief engineering float(like printf "%e")
-  kEngFloat = 6,
-  /// @brief hex float(like printf "%a")
-  kHexFloat = 7,
-  /// @brief automatic "shortest" float(like printf "%g")
-  kAutoFloat = 8,
-};
+/// @brief Most verbose log level that is compiled into the call sites, configured by the VITO_AP_LOG_COMPILE_LEVEL
+/// CMake cache variable. Log statements above it are removed at compile time, irrespective of any runtime threshold.
+inline constexpr LogLevel kCompileLevel{static_cast<LogLevel>(VITO_AP_LOG_COMPILE_LEVEL)};
 
-/// @brief A type holding a formatting hint.
-/// The interpretation of precision depends on fmt:
-/// For integral types(i.e.Fmt::kDec, Fmt::kOct, Fmt::kHex, Fmt::kBin), precision is interpreted as the minimum number
-/// of digits to output, similar to e.g.std::printf("%.7d").
-/// For the floating - point specifiers Fmt::kDecFloat, Fmt::kEngFloat and Fmt::kHexFloat, precision denotes the exact
-/// number of digits to be shown after the decimal point; for Fmt::kAutoFloat, precision denotes the number of
-/// significant digits to be shown according to the rules of the std::printf "%g" specifier.
-/// If fmt is Fmt::kDefault, the precision field is ignored, and an implementation-defined formatting is applied.For
-/// integral types, if precision is 0, it is interpreted the same as if it was 1.
-struct Format {
-  /// @brief the format specifier
-  Fmt fmt;
-  /// @brief the precision to use
-  std::uint16_t precision;
-};
+/// @brief Stream type returned for a log level: LogStream if the level is compiled in, NullLogStream otherwise.
+template <LogLevel log_level>
+using LogStreamFor = std::conditional_t<(log_level <= kCompileLevel), LogStream, NullLogStream>;
 
 /// @brief Create a Format instance with Fmt::kDefault formatting hint.
 /// @return a Format instance
-constexpr Format Dflt() noexcept;
+constexpr Format Dflt() noexcept { return Format{Fmt::kDefault, 0}; }
 
 /// @brief Create a Format instance with Fmt::kDec formatting hint and default precision.
 /// @return a Format instance
-constexpr Format Dec() noexcept;
+constexpr Format Dec() noexcept { return Format{Fmt::kDec, detail::kDefaultIntPrecision}; }
 
 /// @brief Create a Format instance with Fmt::kDec formatting hint and given precision.
 /// @param precision
 /// @return a Format instance
-constexpr Format Dec(std::uint16_t precision) noexcept;
+constexpr Format Dec(std::uint16_t precision) noexcept { return Format{Fmt::kDec, precision}; }
 
 /// @brief Create a Format instance with Fmt::kOct formatting hint and default precision.
 /// @return a Format instance
-constexpr Format Oct() noexcept;
+constexpr Format Oct() noexcept { return Format{Fmt::kOct, detail::kDefaultIntPrecision}; }
 
 /// @brief Create a Format instance with Fmt::kOct formatting hint and given precision.
 /// @param precision the precision to use
 /// @return a Format instance
-constexpr Format Oct(std::uint16_t precision) noexcept;
+constexpr Format Oct(std::uint16_t precision) noexcept { return Format{Fmt::kOct, precision}; }
 
 /// @brief Create a Format instance with Fmt::kHex formatting hint and default precision.
 /// @return a Format instance
-constexpr Format Hex() noexcept;
+constexpr Format Hex() noexcept { return Format{Fmt::kHex, detail::kDefaultIntPrecision}; }
 
 /// @brief Create a Format instance with Fmt::kHex formatting hint and given precision.
 /// @param precision the precision to use
 /// @return a Format instance
-constexpr Format Hex(std::uint16_t precision) noexcept;
+constexpr Format Hex(std::uint16_t precision) noexcept { return Format{Fmt::kHex, precision}; }
 
 /// @brief Create a Format instance with Fmt::kBin formatting hint and default precision.
 /// @return a Format instance
-constexpr Format Bin() noexcept;
+constexpr Format Bin() noexcept { return Format{Fmt::kBin, detail::kDefaultIntPrecision}; }
 
 /// @brief Create a Format instance with Fmt::kBin formatting hint and given precision.
 /// @param precision the precision to use
 /// @return a Format instance
-constexpr Format Bin(std::uint16_t precision) noexcept;
+constexpr Format Bin(std::uint16_t precision) noexcept { return Format{Fmt::kBin, precision}; }
 
 /// @brief Create a Format instance with Fmt::kDecFloat formatting hint and given precision.
 /// @param precision the precision to use
 /// @return a Format instance
-constexpr Format DecFloat(std::uint16_t precision = 6) noexcept;
+constexpr Format DecFloat(std::uint16_t precision = 6) noexcept { return Format{Fmt::kDecFloat, precision}; }
 
 /// @brief Create a Format instance with Fmt::kDecFloat formatting hint and a precision that is sufficient for full
 /// round-trip safety.
 /// @return a Format instance
-constexpr Format DecFloatMax() noexcept;
+constexpr Format DecFloatMax() noexcept { return DecFloat(detail::kMaxFloatPrecision); }
 
 /// @brief Create a Format instance with Fmt::kEngFloat formatting hint and given precision.
 /// @param precision the precision to use
 /// @return a Format instance
-constexpr Format EngFloat(std::uint16_t precision = 6) noexcept;
+constexpr Format EngFloat(std::uint16_t precision = 6) noexcept { return Format{Fmt::kEngFloat, precision}; }
 
 /// @brief Create a Format instance with Fmt::kEngFloat formatting hint and a precision that is sufficient for full
 /// round-trip safety.
 /// @return a Format instance
-constexpr Format EngFloatMax() noexcept;
+constexpr Format EngFloatMax() noexcept { return EngFloat(detail::kMaxFloatPrecision); }
 
 /// @brief Create a Format instance with Fmt::kHexFloat formatting hint and given precision.
 /// @param precision the precision to use
 /// @return a Format instance
-constexpr Format HexFloat(std::uint16_t precision) noexcept;
+constexpr Format HexFloat(std::uint16_t precision) noexcept { return Format{Fmt::kHexFloat, precision}; }
 
 /// @brief Create a Format instance with Fmt::kHexFloat formatting hint and a precision that is sufficient for full
 /// round-trip safety.
 /// @return a Format instance
-constexpr Format HexFloatMax() noexcept;
+constexpr Format HexFloatMax() noexcept { return HexFloat(detail::kMaxFloatPrecision); }
 
 /// @brief Create a Format instance with Fmt::kAutoFloat formatting hint and given precision.
 /// @param precision the precision to use
 /// @return a Format instance
-constexpr Format AutoFloat(std::uint16_t precision = 6) noexcept;
+constexpr Format AutoFloat(std::uint16_t precision = 6) noexcept { return Format{Fmt::kAutoFloat, precision}; }
 
 /// @brief Create a Format instance with Fmt::kAutoFloat formatting hint and a precision that is sufficient for full
 /// round-trip safety.
 /// @return a Format instance
-constexpr Format AutoFloatMax() noexcept;
+constexpr Format AutoFloatMax() noexcept { return AutoFloat(detail::kMaxFloatPrecision); }
 
 /// @brief Interface for sending log messages.
 class Logger {
@@ -137,59 +116,147 @@ class Logger {
   /// @brief Creates a LogStream object.
   /// Returned object will accept arguments via the insert stream operator "@c <<".
   /// @return LogStream object of Fatal severity.
-  [[nodiscard]] LogStream LogFatal() const noexcept;
+  [[nodiscard]] LogStreamFor<LogLevel::kFatal> LogFatal() const noexcept { return MakeStream<LogLevel::kFatal>(); }
 
   /// @brief Same as Logger::LogFatal().
   /// @return LogStream object of Error severity.
-  [[nodiscard]] LogStream LogError() const noexcept;
+  [[nodiscard]] LogStreamFor<LogLevel::kError> LogError() const noexcept { return MakeStream<LogLevel::kError>(); }
 
   /// @brief Same as Logger::LogFatal().
   /// @return LogStream object of Warn severity.
-  [[nodiscard]] LogStream LogWarn() const noexcept;
+  [[nodiscard]] LogStreamFor<LogLevel::kWarn> LogWarn() const noexcept { return MakeStream<LogLevel::kWarn>(); }
 
   /// @brief Same as Logger::LogFatal().
   /// @return LogStream object of Info severity.
-  [[nodiscard]] LogStream LogInfo() const noexcept;
+  [[nodiscard]] LogStreamFor<LogLevel::kInfo> LogInfo() const noexcept { return MakeStream<LogLevel::kInfo>(); }
 
   /// @brief Same as Logger::LogFatal().
   /// @return LogStream object of Debug severity.
-  [[nodiscard]] LogStream LogDebug() const noexcept;
+  [[nodiscard]] LogStreamFor<LogLevel::kDebug> LogDebug() const noexcept { return MakeStream<LogLevel::kDebug>(); }
 
   /// @brief Same as Logger::LogFatal().
   /// @return LogStream object of Verbose severity.
-  [[nodiscard]] LogStream LogVerbose() const noexcept;
+  [[nodiscard]] LogStreamFor<LogLevel::kVerbose> LogVerbose() const noexcept {
+    return MakeStream<LogLevel::kVerbose>();
+  }
 
   /// @brief Check current configured log reporting level.
   /// Applications may want to check the actual configured reporting log level of certain loggers before doing log data
   /// preparation that is runtime intensive.
   /// @param log_level The to be checked log level.
   /// @return True if desired log level satisfies the configured reporting level.
-  [[nodiscard]] bool IsEnabled(LogLevel log_level) const noexcept;
+  [[nodiscard]] bool IsEnabled(LogLevel log_level) const noexcept {
+    return log_level <= kCompileLevel && log_level <= enabled_level_->load(std::memory_order_relaxed);
+  }
 
   /// @brief Log message with a programmatically determined log level can be written.
   /// @param log_level the log level to use for this LogStream instance
   /// @return a new LogStream instance with the given log level
   [[nodiscard]] LogStream WithLevel(LogLevel log_level) const noexcept;
 
+  /// @brief Log message with a programmatically determined log level, subject to a rate limit.
+  /// The level is checked first and the limit second, so filtered messages do not count against the limit; a message
+  /// the limit suppresses is counted for the summary and returns an inert LogStream, for which nothing is built.
+  /// @param log_level the log level to use for this LogStream instance
+  /// @param limit the limit of the call site, usually a static (see LogLimit)
+  /// @return a new LogStream instance with the given log level
+  [[nodiscard]] LogStream WithLimit(LogLevel log_level, LogLimit& limit) const noexcept {
+    if (!IsEnabled(log_level)) {
+      return {};
+    }
+    if (!limit.Allow()) {
+      limit.Suppress(GetContextHandle(), log_level);
+      return {};
+    }
+    return {log_level, *this};
+  }
+
+  /// @brief Log a message whose payload is only produced if log_level is enabled.
+  /// fn receives the LogStream of the message and may add arguments, the source location and tags to it. If log_level
+  /// is filtered fn is not invoked, so expensive operands (string conversions, formatting, container dumps) placed
+  /// inside it cost nothing.
+  /// @tparam Fn callable type invocable with a LogStream&
+  /// @param log_level the log level to use for the message
+  /// @param fn the callable producing the message payload
+  template <typename Fn, std::enable_if_t<std::is_invocable_v<Fn, LogStream&>, bool> = true>
+  void LogLazy(LogLevel log_level, Fn&& fn) const {
+    if (IsEnabled(log_level)) {
+      LogStream stream{log_level, *this};
+      std::invoke(std::forward<Fn>(fn), stream);
+    }
+  }
+
   /// @brief Log a modeled message.
   /// If this function is called with an argument list that does not match the modeled message, the program is
-  /// ill-formed.
+  /// ill-formed. The message is sent in non-verbose mode: its id and the raw argument values, converted to the modeled
+  /// argument types, without type information or ECU, application and context ids.
   /// @tparam MsgId the type of the id parameter
   /// @tparam Params the types of the args parameters
-  /// @param id an implementation-defined type identifying the message object
+  /// @param id an implementation-defined type identifying the message object, a subclass of ModeledMessage
   /// @param args the arguments to add to the message
   template <typename MsgId, typename... Params>
-  void Log(const MsgId& id, const Params&... args) noexcept {}
-
+  void Log([[maybe_unused]] const MsgId& id, const Params&... args) noexcept {
+    using Arguments = typename MsgId::Arguments;
+    static_assert(sizeof...(Params) == std::tuple_size_v<Arguments>, "wrong number of arguments for the message");
+    static_assert(MsgId::kArguments.size() == std::tuple_size_v<Arguments>, "kArguments does not match the message");
+    static_assert(detail::CountPlaceholders(MsgId::kFormat) == std::tuple_size_v<Arguments>,
+                  "kFormat needs one {} per argument");
+    // referencing the catalog entry is what places it in the binary
+    [[maybe_unused]] static constexpr const void* kCatalogEntry{&detail::CatalogEntry<MsgId>::kData};
+
+    if (IsEnabled(MsgId::kLogLevel)) {
+      std::apply(
+          [this](const auto&... values) {
+            const std::array<core::Span<const core::Byte>, sizeof...(values)> arguments{
+                detail::ArgumentBytes(values)...};
+            LogModeled(detail::kModeledMessageInfo<MsgId>, arguments);
+          },
+          Arguments{args...});
+    }
+  }
+
+  /// @brief Log a modeled message with attributes.
+  /// No attribute types are defined yet, so attrs must be empty.
   template <typename... Attrs, typename MsgId, typename... Params>
-  void LogWith(const std::tuple<Attrs...>& attrs, const MsgId& msg_id, const Params&... params) noexcept {}
+  void LogWith([[maybe_unused]] const std::tuple<Attrs...>& attrs, const MsgId& msg_id,
+               const Params&... params) noexcept {
+    static_assert(sizeof...(Attrs) == 0, "unsupported message attribute");
+    Log(msg_id, params...);
+  }
 
   /// @brief Set log level threshold for this Logger instance.
+  /// The new threshold is visible to all threads (and all copies of this Logger) without further synchronization. It
+  /// pins the threshold of the context, as setting it over the control channel does: later changes of the default
+  /// threshold (SetDefaultLogLevel over the control channel) leave this context at the threshold set here.
   /// @param threshold the new threshold
   void SetThreshold(LogLevel threshold);
 
+  /// @brief Capture messages of this context up to log_level that are below the threshold, instead of dropping them.
+  /// Captured messages are kept unformatted in a fixed-size ring of the logging thread, and emitted in front of the
+  /// next Error or Fatal message of that thread (see "Backtrace" in the manifest).
+  /// @param log_level the most verbose level captured, LogLevel::kOff to capture nothing
+  void SetBacktraceLevel(LogLevel log_level);
+
+  /// @brief Return the handle of the context of this Logger.
+  [[nodiscard]] ContextHandle GetContextHandle() const noexcept;
+
  private:
-  Logger(core::StringView ctx_id, core::StringView ctx_desc, LogLevel threshold);
+  struct Impl;
+
+  explicit Logger(Impl& impl);
+
+  template <LogLevel log_level>
+  LogStreamFor<log_level> MakeStream() const noexcept {
+    if constexpr (log_level <= kCompileLevel) {
+      // checked inline, so a filtered statement does not even call into the library to build its inert stream
+      if (!IsEnabled(log_level)) {
+        return LogStream{};
+      }
+      return {log_level, *this};
+    } else {
+      return {};
+    }
+  }
 
   [[nodiscard]] const Key& GetKey() const;
 
@@ -197,11 +264,19 @@ class Logger {
 
   void Handle(std::shared_ptr<dlt::Message> message);
 
+  /// @brief Send a modeled message.
+  /// @param info the descriptor of the message
+  /// @param arguments the argument values in host byte order, as described by info.argument_types
+  void LogModeled(const detail::ModeledMessageInfo& info, core::Span<const core::Span<const core::Byte>> arguments);
+
  private:
-  friend class LoggerManager;
+  friend class ContextRegistry;
   friend class LogStream;
-  struct Impl;
-  std::shared_ptr<Impl> impl_;
+  /// @brief the state of the context, owned by the context registry, so that copying a Logger is copying two pointers
+  Impl* impl_;
+  /// @brief most verbose level both within the threshold and taken by some sink, or captured for the backtrace, owned
+  /// by impl_, so that IsEnabled() is a single relaxed load inlined at the call site.
+  const std::atomic<LogLevel>* enabled_level_;
 };
 
 /// @brief Creates a Logger object, holding the context which is registered in the Logging framework. If no model is
@@ -212,12 +287,18 @@ class Logger {
 /// @return Reference to the internal managed instance of a Logger object. Ownership stays within the Logging framework.
 Logger& CreateLogger(core::StringView ctx_id, core::StringView ctx_desc, LogLevel ctx_def_log_level = LogLevel::kWarn);
 
+/// @brief Fetches the connection state from the DLT back-end of a possibly available remote client.
+/// @return the current client state; ClientState::kUnknown if no "NETWORK" sink is configured or its first connection
+/// attempt has not completed yet
+ClientState RemoteClientState() noexcept;
+
 /// @brief Create a wrapper object for the given arguments.
 /// Calling this function shall be ill-formed if any of these conditions are met:
 /// - T is not an arithmetic type and not "bool" and not convertible to "ara::core::StringView" and not convertible to
 /// "ara::core::Span<const ara::core::Byte>".
 /// - T is convertible to "ara::core::StringView" or convertible to "ara::core::Span<const ara::core::Byte>" or "bool",
 /// and "unit" is not "nullptr"
+/// The last condition cannot be checked at compile time; such a unit is ignored, as DLT has no unit for these types.
 /// @param arg an argument payload object
 /// @param name an optional "name" attribute for arg
 /// @param unit an optional "unit" attribute for arg
@@ -225,8 +306,9 @@ Logger& CreateLogger(core::StringView ctx_id, core::StringView ctx_desc, LogLeve
 /// implementation’s standard formatting
 /// @return a wrapper object holding the supplied arguments
 template <typename T>
-Argument<T> Arg(T&& arg, const char* name = nullptr, const char* unit = nullptr, Format format = Dflt()) {
-  return Argument<T>{};  // TODO
+constexpr Argument<T> Arg(T&& arg, const char* name = nullptr, const char* unit = nullptr,
+                          Format format = Dflt()) noexcept {
+  return Argument<T>{typename Argument<T>::ValueType(arg), name, unit, format};
 }
 }  // namespace ara::log
 #endif  // !VITO_AP_LOGGER_H_
@@ -0,0 +1,181 @@
+#ifndef VITO_AP_MODELED_MESSAGE_H_
+#define VITO_AP_MODELED_MESSAGE_H_
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "ara/core/span.h"
+#include "ara/core/string_view.h"
+#include "ara/core/utility.h"
+#include "ara/log/common.h"
+
+namespace ara::log {
+/// @brief Name and unit of an argument of a modeled message, as exported to the message catalog.
+struct ArgumentInfo {
+  core::StringView name;
+  core::StringView unit;
+};
+
+/// @brief Type of an argument of a modeled message, which determines its encoding on the wire.
+enum class ArgumentType : std::uint8_t {
+  kBool = 0,
+  kUint8 = 1,
+  kUint16 = 2,
+  kUint32 = 3,
+  kUint64 = 4,
+  kInt8 = 5,
+  kInt16 = 6,
+  kInt32 = 7,
+  kInt64 = 8,
+  kFloat32 = 9,
+  kFloat64 = 10,
+  /// @brief UTF-8 text: 16 bit length including the terminating NUL, the text and the NUL
+  kString = 11,
+  /// @brief bytes: 16 bit length and the bytes
+  kRaw = 12,
+};
+
+namespace detail {
+template <typename T>
+constexpr ArgumentType ArgumentTypeOf() {
+  if constexpr (std::is_same_v<T, bool>) {
+    return ArgumentType::kBool;
+  } else if constexpr (std::is_integral_v<T>) {
+    static_assert(sizeof(T) <= 8, "unsupported argument type");
+    constexpr auto index{sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3};
+    return static_cast<ArgumentType>((std::is_signed_v<T> ? 5 : 1) + index);
+  } else if constexpr (std::is_same_v<T, float>) {
+    return ArgumentType::kFloat32;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return ArgumentType::kFloat64;
+  } else if constexpr (std::is_same_v<T, core::StringView>) {
+    return ArgumentType::kString;
+  } else {
+    static_assert(std::is_same_v<T, core::Span<const core::Byte>>, "unsupported argument type");
+    return ArgumentType::kRaw;
+  }
+}
+
+/// @brief Return the number of "{}" placeholders in format.
+constexpr std::size_t CountPlaceholders(core::StringView format) {
+  std::size_t count{0};
+  for (auto pos = format.find("{}"); pos != core::StringView::npos; pos = format.find("{}", pos + 2)) {
+    ++count;
+  }
+  return count;
+}
+}  // namespace detail
+
+/// @brief Base of the types identifying modeled (non-verbose) messages.
+/// A modeled message binds, at compile time, a message id, a log level, the argument types and a descriptor: the text
+/// with one "{}" per argument, and a name and unit per argument. Only the id and the raw argument values are sent;
+/// the descriptor is exported to the message catalog of the executable, from which a decoder renders the message.
+/// @code
+/// struct VehicleSpeed : ara::log::ModeledMessage<0x100, ara::log::LogLevel::kInfo, std::uint32_t, double> {
+///   static constexpr ara::core::StringView kFormat{"sample {} speed {}"};
+///   static constexpr std::array<ara::log::ArgumentInfo, 2> kArguments{{{"sample", ""}, {"speed", "km/h"}}};
+/// };
+///
+/// logger.Log(VehicleSpeed{}, sample, speed);
+/// @endcode
+/// @tparam id the message id, unique within the executable
+/// @tparam log_level the log level of the message
+/// @tparam Params the argument types: bool, integers of up to 64 bits, float, double, core::StringView and
+/// core::Span<const core::Byte>
+template <std::uint32_t id, LogLevel log_level, typename... Params>
+struct ModeledMessage {
+  static constexpr std::uint32_t kId{id};
+  static constexpr LogLevel kLogLevel{log_level};
+  using Arguments = std::tuple<Params...>;
+  static constexpr std::array<ArgumentType, sizeof...(Params)> kArgumentTypes{detail::ArgumentTypeOf<Params>()...};
+};
+
+namespace detail {
+/// @brief The descriptor of a modeled message, as used when rendering it in the process.
+struct ModeledMessageInfo {
+  std::uint32_t id;
+  LogLevel log_level;
+  core::StringView format;
+  core::Span<const ArgumentInfo> arguments;
+  core::Span<const ArgumentType> argument_types;
+};
+
+template <typename MsgId>
+inline constexpr ModeledMessageInfo kModeledMessageInfo{MsgId::kId, MsgId::kLogLevel, MsgId::kFormat,
+                                                        MsgId::kArguments, MsgId::kArgumentTypes};
+
+constexpr core::StringView ArgumentTypeName(ArgumentType type) {
+  constexpr std::array<core::StringView, 13> kNames{"bool",  "uint8", "uint16", "uint32",  "uint64",  "int8", "int16",
+                                                    "int32", "int64", "float32", "float64", "string", "raw"};
+  return kNames[static_cast<std::size_t>(type)];
+}
+
+template <typename MsgId>
+constexpr std::size_t CatalogEntrySize() {
+  // size, id, log level, number of arguments and the NUL terminated format
+  std::size_t size{4 + 4 + 1 + 1 + MsgId::kFormat.size() + 1};
+  for (std::size_t i{0}; i < MsgId::kArgumentTypes.size(); ++i) {
+    size += ArgumentTypeName(MsgId::kArgumentTypes[i]).size() + 1 + MsgId::kArguments[i].name.size() + 1 +
+            MsgId::kArguments[i].unit.size() + 1;
+  }
+  return size;
+}
+
+/// @brief Encode the descriptor of a modeled message as a catalog entry, without any pointers, so that the catalog
+/// can be read from the executable file as is. Integers are little-endian; strings are NUL terminated. The entry is
+/// its size (4 bytes), the id (4), the log level (1), the number of arguments (1) and the format, followed by the
+/// type name, name and unit of each argument.
+template <typename MsgId>
+constexpr std::array<char, CatalogEntrySize<MsgId>()> MakeCatalogEntry() {
+  std::array<char, CatalogEntrySize<MsgId>()> entry{};
+  std::size_t pos{0};
+  const auto write_uint32 = [&entry, &pos](std::uint32_t value) {
+    for (std::size_t i{0}; i < 4; ++i) {
+      entry[pos++] = static_cast<char>(value >> (i * 8) & 0xFFU);
+    }
+  };
+  const auto write_string = [&entry, &pos](core::StringView value) {
+    for (const auto c : value) {
+      entry[pos++] = c;
+    }
+    entry[pos++] = '\0';
+  };
+
+  write_uint32(static_cast<std::uint32_t>(entry.size()));
+  write_uint32(MsgId::kId);
+  entry[pos++] = static_cast<char>(MsgId::kLogLevel);
+  entry[pos++] = static_cast<char>(MsgId::kArgumentTypes.size());
+  write_string(MsgId::kFormat);
+  for (std::size_t i{0}; i < MsgId::kArgumentTypes.size(); ++i) {
+    write_string(ArgumentTypeName(MsgId::kArgumentTypes[i]));
+    write_string(MsgId::kArguments[i].name);
+    write_string(MsgId::kArguments[i].unit);
+  }
+  return entry;
+}
+
+/// @brief The catalog entry of a modeled message, emitted into the binary once the message is logged anywhere in it.
+/// Instantiations are merged by the linker, so each message appears once; the log_catalog tool collects them by
+/// their symbol name.
+template <typename MsgId>
+struct CatalogEntry {
+  [[gnu::used]] static constexpr std::array<char, CatalogEntrySize<MsgId>()> kData{MakeCatalogEntry<MsgId>()};
+};
+
+/// @brief Return the bytes sent for an argument of a modeled message, in host byte order.
+template <typename T>
+core::Span<const core::Byte> ArgumentBytes(const T& value) {
+  if constexpr (std::is_same_v<T, core::StringView>) {
+    return std::as_bytes(core::Span<const char>{value.data(), value.size()});
+  } else if constexpr (std::is_same_v<T, core::Span<const core::Byte>>) {
+    return value;
+  } else {
+    return std::as_bytes(core::Span<const T, 1>{&value, 1});
+  }
+}
+}  // namespace detail
+}  // namespace ara::log
+
+#endif  // !VITO_AP_MODELED_MESSAGE_H_
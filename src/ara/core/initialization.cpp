@@ -18,6 +18,11 @@ Result<void> InitLogModule() noexcept {
   return R::FromValue();
 }
 
+Result<void> DeinitLogModule() noexcept {
+  log::LoggerManager::Instance().Deinit();
+  return Result<void>::FromValue();
+}
+
 Result<void> Initialize() noexcept {
   using R = Result<void>;
 
@@ -30,6 +35,11 @@ Result<void> Initialize() noexcept {
 
 Result<void> Deinitialize() noexcept {
   using R = Result<void>;
+
+  if (const auto result{DeinitLogModule()}; !result) {
+    return R::FromError(result.Error());
+  }
+
   return R::FromValue();
 }
 
@@ -0,0 +1,173 @@
+#include "ara/log/async_dispatcher.h"
+
+#include <pthread.h>
+
+#include <bit>
+
+#include "ara/log/dlt_message.h"
+
+namespace ara::log {
+AsyncDispatcher::AsyncDispatcher(const AsyncConfig& config,
+                                 const core::Vector<std::unique_ptr<LoggingHandler>>& handlers, Coalescer* coalescer)
+    : overflow_policy_{config.overflow_policy},
+      handlers_{handlers},
+      coalescer_{coalescer},
+      queue_{config.queue_capacity} {
+  writer_ = std::thread{&AsyncDispatcher::Run, this};
+  pthread_setname_np(writer_.native_handle(), "ara_log_writer");
+}
+
+AsyncDispatcher::~AsyncDispatcher() { Stop(); }
+
+void AsyncDispatcher::Push(std::shared_ptr<dlt::Message> message) {
+  // announced before checking stopping_, so that Stop() either waits for this push or it is seen here
+  pushing_.fetch_add(1, std::memory_order_seq_cst);
+  Enqueue(std::move(message));
+  if (pushing_.fetch_sub(1, std::memory_order_acq_rel) == 1 && stopping_.load(std::memory_order_relaxed)) {
+    pushing_.notify_all();
+  }
+}
+
+void AsyncDispatcher::Enqueue(std::shared_ptr<dlt::Message> message) {
+  if (stopping_.load(std::memory_order_seq_cst)) {
+    EmitToSinks(message);
+    return;
+  }
+
+  while (!queue_.TryPush(std::move(message))) {
+    switch (overflow_policy_) {
+      case OverflowPolicy::kDropNewest:
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      case OverflowPolicy::kDropOldest:
+        if (std::shared_ptr<dlt::Message> oldest; queue_.TryPop(oldest)) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        break;
+      case OverflowPolicy::kBlock:
+        WaitForSpace();
+        if (stopping_.load(std::memory_order_acquire)) {
+          EmitToSinks(message);
+          return;
+        }
+        break;
+    }
+  }
+  WakeWriter();
+}
+
+void AsyncDispatcher::Stop() {
+  if (stopping_.exchange(true, std::memory_order_seq_cst)) {
+    return;
+  }
+
+  {
+    std::scoped_lock lock{message_mutex_};
+    ++message_signal_;
+  }
+  message_wake_.notify_one();
+  space_signal_.fetch_add(1, std::memory_order_release);
+  space_signal_.notify_all();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+
+  // producers that checked stopping_ before it was set may still be queueing; wait until they are done
+  for (auto pushing = pushing_.load(std::memory_order_seq_cst); pushing != 0;
+       pushing = pushing_.load(std::memory_order_acquire)) {
+    pushing_.wait(pushing, std::memory_order_acquire);
+  }
+
+  // messages queued by producers that raced with the writer's last pass
+  std::shared_ptr<dlt::Message> message;
+  while (queue_.TryPop(message)) {
+    Emit(message);
+  }
+}
+
+AsyncDispatcher::Statistics AsyncDispatcher::GetStatistics() const {
+  return Statistics{dropped_.load(std::memory_order_relaxed), blocked_.load(std::memory_order_relaxed)};
+}
+
+void AsyncDispatcher::Run() {
+  std::shared_ptr<dlt::Message> message;
+  while (true) {
+    while (queue_.TryPop(message)) {
+      WakeProducers();
+      Emit(message);
+      // drop the reference here, so the message returns to its pool without waiting for the next one
+      message.reset();
+    }
+    if (stopping_.load(std::memory_order_acquire)) {
+      return;
+    }
+    // records of ended coalescing windows are due even if no message comes
+    WaitForMessages(coalescer_ ? coalescer_->Sweep(std::chrono::steady_clock::now())
+                               : std::chrono::steady_clock::time_point::max());
+  }
+}
+
+void AsyncDispatcher::Emit(const std::shared_ptr<dlt::Message>& message) const {
+  if (coalescer_) {
+    coalescer_->Emit(message);
+    return;
+  }
+  EmitToSinks(message);
+}
+
+void AsyncDispatcher::EmitToSinks(const std::shared_ptr<dlt::Message>& message) const {
+  for (auto sinks = message->Sinks(); sinks != 0; sinks &= sinks - 1) {
+    handlers_[std::countr_zero(sinks)]->Emit(message);
+  }
+}
+
+void AsyncDispatcher::WaitForMessages(std::chrono::steady_clock::time_point deadline) {
+  writer_waiting_.store(true, std::memory_order_relaxed);
+  // pairs with the fence in WakeWriter(): either the producer sees writer_waiting_, or we see its message
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  {
+    std::unique_lock lock{message_mutex_};
+    // checked under the lock, which a waking producer or Stop() takes to bump the signal
+    if (queue_.Empty() && !stopping_.load(std::memory_order_acquire)) {
+      const auto woken = [this, ticket = message_signal_] { return message_signal_ != ticket; };
+      if (deadline == std::chrono::steady_clock::time_point::max()) {
+        message_wake_.wait(lock, woken);
+      } else {
+        message_wake_.wait_until(lock, deadline, woken);
+      }
+    }
+  }
+  writer_waiting_.store(false, std::memory_order_relaxed);
+}
+
+void AsyncDispatcher::WakeWriter() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (writer_waiting_.load(std::memory_order_relaxed)) {
+    {
+      std::scoped_lock lock{message_mutex_};
+      ++message_signal_;
+    }
+    message_wake_.notify_one();
+  }
+}
+
+void AsyncDispatcher::WaitForSpace() {
+  blocked_.fetch_add(1, std::memory_order_relaxed);
+  const auto ticket = space_signal_.load(std::memory_order_acquire);
+  waiting_producers_.fetch_add(1, std::memory_order_relaxed);
+  // pairs with the fence in WakeProducers(): either the writer sees waiting_producers_, or we see the room it made
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (queue_.Full() && !stopping_.load(std::memory_order_acquire)) {
+    space_signal_.wait(ticket, std::memory_order_acquire);
+  }
+  waiting_producers_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void AsyncDispatcher::WakeProducers() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting_producers_.load(std::memory_order_relaxed) > 0) {
+    space_signal_.fetch_add(1, std::memory_order_release);
+    space_signal_.notify_all();
+  }
+}
+}  // namespace ara::log
@@ -0,0 +1,38 @@
+#include "ara/log/backtrace.h"
+
+#include <algorithm>
+
+#include "ara/log/logger_manager.h"
+
+namespace ara::log {
+Backtrace& Backtrace::Local() {
+  thread_local Backtrace backtrace{LogConfig::Instance().Backtrace().depth};
+  return backtrace;
+}
+
+Backtrace::Backtrace(std::size_t depth) : depth_{depth} {}
+
+void Backtrace::Capture(const dlt::Message& message) {
+  if (depth_ == 0) {
+    return;
+  }
+  if (slots_.size() < depth_) {
+    // next_ is the end of the ring while it fills up
+    slots_.reserve(depth_);
+    slots_.push_back(message);
+  } else {
+    slots_[next_].Assign(message);
+  }
+  next_ = (next_ + 1) % depth_;
+  size_ = std::min(size_ + 1, depth_);
+}
+
+void Backtrace::Dump(SinkMask sinks) {
+  // the oldest message is size_ slots behind next_
+  for (auto index = next_ + depth_ - size_; size_ > 0; --size_, ++index) {
+    auto message = dlt::Message::Copy(slots_[index % depth_]);
+    message->SetSinks(sinks);
+    LoggerManager::Instance().Handle(std::move(message));
+  }
+}
+}  // namespace ara::log
@@ -0,0 +1,93 @@
+#include "ara/log/coalescer.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+/// @brief context ids up to this length are taken over without allocating
+constexpr std::size_t kReservedCtxIdSize{32};
+}  // namespace
+
+namespace ara::log {
+Coalescer::Coalescer(const CoalesceConfig& config, const core::Vector<std::unique_ptr<LoggingHandler>>& handlers)
+    : window_{config.window}, handlers_{handlers}, entries_(std::bit_ceil(config.capacity)) {
+  for (auto& entry : entries_) {
+    entry.ctx_id.reserve(kReservedCtxIdSize);
+  }
+}
+
+void Coalescer::Emit(const std::shared_ptr<dlt::Message>& message) {
+  const auto now = std::chrono::steady_clock::now();
+  // windows of messages that stopped repeating are closed at most once per window length
+  if (now >= next_sweep_) {
+    Sweep(now);
+    next_sweep_ = now + window_;
+  }
+
+  const auto hash = message->ContentHash();
+  auto& entry = entries_[hash & (entries_.size() - 1)];
+  if (entry.active && entry.hash == hash && now < entry.window_end) {
+    ++entry.repeats;
+    return;
+  }
+
+  Close(entry);
+  entry.active = true;
+  entry.hash = hash;
+  entry.window_end = now + window_;
+  entry.repeats = 0;
+  entry.log_level = message->GetLogLevel();
+  entry.sinks = message->Sinks();
+  entry.ctx_id = message->CtxId();
+  entry.modeled_info = message->ModeledInfo();
+  if (!entry.modeled_info) {
+    entry.arguments.Assign(message->GetPayload());
+  }
+  EmitToSinks(message);
+}
+
+void Coalescer::Flush() {
+  for (auto& entry : entries_) {
+    Close(entry);
+  }
+}
+
+void Coalescer::Close(Entry& entry) {
+  if (!entry.active) {
+    return;
+  }
+  entry.active = false;
+  if (entry.repeats == 0) {
+    return;
+  }
+  // taken from the pool of the consumer thread, so records do not allocate either once it is warm
+  auto record = dlt::Message::VerboseModeLogMessage(entry.log_level, entry.ctx_id);
+  if (entry.modeled_info) {
+    record->AddArgument(entry.modeled_info->format);
+  } else {
+    record->AddArguments(entry.arguments);
+  }
+  // rendered as "repeated=N times"
+  record->AddArgument(entry.repeats, ArgumentAttributes{"repeated", "times", Format{Fmt::kDefault, 0}});
+  record->SetSinks(entry.sinks);
+  EmitToSinks(record);
+}
+
+std::chrono::steady_clock::time_point Coalescer::Sweep(std::chrono::steady_clock::time_point now) {
+  auto next_end = std::chrono::steady_clock::time_point::max();
+  for (auto& entry : entries_) {
+    if (entry.active && now >= entry.window_end) {
+      Close(entry);
+    } else if (entry.active) {
+      next_end = std::min(next_end, entry.window_end);
+    }
+  }
+  return next_end;
+}
+
+void Coalescer::EmitToSinks(const std::shared_ptr<dlt::Message>& message) const {
+  for (auto sinks = message->Sinks(); sinks != 0; sinks &= sinks - 1) {
+    handlers_[std::countr_zero(sinks)]->Emit(message);
+  }
+}
+}  // namespace ara::log
@@ -0,0 +1,215 @@
+#include "ara/log/context_registry.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+namespace ara::log {
+void Logger::Impl::SetThreshold(LogLevel level) {
+  threshold.store(level, std::memory_order_relaxed);
+  UpdateLevels();
+}
+
+void Logger::Impl::Route(const LevelSinks& level_sinks) {
+  auto most_verbose = LogLevel::kOff;
+  for (std::size_t level{0}; level < level_sinks.size(); ++level) {
+    sinks[level].store(level_sinks[level], std::memory_order_relaxed);
+    if (level_sinks[level] != 0) {
+      most_verbose = static_cast<LogLevel>(level);
+    }
+  }
+  routed_level.store(most_verbose, std::memory_order_relaxed);
+  UpdateLevels();
+}
+
+void Logger::Impl::SetBacktraceLevel(LogLevel level) {
+  backtrace_level.store(level, std::memory_order_relaxed);
+  UpdateLevels();
+}
+
+void Logger::Impl::UpdateLevels() {
+  const auto emitted =
+      std::min(threshold.load(std::memory_order_relaxed), routed_level.load(std::memory_order_relaxed));
+  emitted_level.store(emitted, std::memory_order_relaxed);
+  enabled_level.store(std::max(emitted, backtrace_level.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+}
+
+ContextRegistry::Context::Context(ContextHandle handle, core::StringView ctx_id, core::StringView ctx_desc,
+                                  LogLevel threshold)
+    : impl{handle, core::String{ctx_id}, core::String{ctx_desc}, threshold}, logger{impl} {}
+
+ContextRegistry::ContextRegistry() {
+  indexes_.push_back(std::make_unique<Index>(kFirstIndexSize));
+  index_.store(indexes_.back().get(), std::memory_order_relaxed);
+}
+
+Logger& ContextRegistry::GetOrCreate(core::StringView ctx_id, core::StringView ctx_desc, LogLevel threshold) {
+  if (auto* const logger = Find(ctx_id)) {
+    return *logger;
+  }
+
+  std::scoped_lock lock{mutex_};
+  // another thread may have created it meanwhile
+  if (auto* const logger = Find(ctx_id)) {
+    return *logger;
+  }
+  const auto handle = size_.load(std::memory_order_relaxed);
+  const auto [chunk, position] = Locate(handle);
+  if (!chunks_[chunk]) {
+    chunks_[chunk] = std::make_unique<core::Optional<Context>[]>(kFirstChunkSize << chunk);
+  }
+  auto& context = chunks_[chunk][position].emplace(handle, ctx_id, ctx_desc, default_threshold_.value_or(threshold));
+  Route(context.impl);
+  ApplyBacktrace(context.impl);
+  size_.store(handle + 1, std::memory_order_release);
+
+  // keep the table at most half full, so that probe sequences stay short
+  auto* const index = index_.load(std::memory_order_relaxed);
+  if (2 * (handle + 1) <= index->size()) {
+    Insert(*index, handle);
+  } else {
+    auto larger = std::make_unique<Index>(index->size() * 2);
+    for (ContextHandle existing{0}; existing <= handle; ++existing) {
+      Insert(*larger, existing);
+    }
+    index_.store(larger.get(), std::memory_order_release);
+    indexes_.push_back(std::move(larger));
+  }
+  return context.logger;
+}
+
+Logger* ContextRegistry::Find(ContextHandle handle) {
+  if (handle >= size_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return &At(handle).logger;
+}
+
+Logger* ContextRegistry::Find(core::StringView ctx_id) {
+  const auto& index = *index_.load(std::memory_order_acquire);
+  const auto mask = index.size() - 1;
+  for (auto slot = std::hash<core::StringView>{}(ctx_id) & mask;; slot = (slot + 1) & mask) {
+    const auto entry = index[slot].load(std::memory_order_acquire);
+    if (entry == 0) {
+      return nullptr;
+    }
+    if (auto& context = At(entry - 1); context.impl.ctx_id == ctx_id) {
+      return &context.logger;
+    }
+  }
+}
+
+std::size_t ContextRegistry::Size() const { return size_.load(std::memory_order_acquire); }
+
+core::Optional<ContextRegistry::ContextInfo> ContextRegistry::Info(ContextHandle handle) {
+  if (handle >= size_.load(std::memory_order_acquire)) {
+    return std::nullopt;
+  }
+  const auto& impl = At(handle).impl;
+  return ContextInfo{impl.ctx_id, impl.ctx_desc, impl.threshold.load(std::memory_order_relaxed)};
+}
+
+void ContextRegistry::SetThreshold(ContextHandle handle, LogLevel threshold) {
+  std::scoped_lock lock{mutex_};
+  if (handle >= size_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  auto& impl = At(handle).impl;
+  impl.own_threshold = true;
+  impl.SetThreshold(threshold);
+}
+
+void ContextRegistry::SetDefaultThreshold(LogLevel threshold) {
+  std::scoped_lock lock{mutex_};
+  default_threshold_ = threshold;
+  const auto size = size_.load(std::memory_order_relaxed);
+  for (ContextHandle handle{0}; handle < size; ++handle) {
+    if (auto& impl = At(handle).impl; !impl.own_threshold) {
+      impl.SetThreshold(threshold);
+    }
+  }
+}
+
+LogLevel ContextRegistry::DefaultThreshold() {
+  std::scoped_lock lock{mutex_};
+  return default_threshold_.value_or(LogLevel::kWarn);
+}
+
+void ContextRegistry::SetRoutes(const core::Vector<RouteConfig>& routes, std::size_t sink_count) {
+  std::scoped_lock lock{mutex_};
+  routes_ = routes;
+  all_sinks_ = sink_count < kMaxSinks ? (SinkMask{1} << sink_count) - 1 : ~SinkMask{0};
+  const auto size = size_.load(std::memory_order_relaxed);
+  for (ContextHandle handle{0}; handle < size; ++handle) {
+    Route(At(handle).impl);
+  }
+}
+
+void ContextRegistry::SetBacktraceLevel(ContextHandle handle, LogLevel log_level) {
+  std::scoped_lock lock{mutex_};
+  if (handle >= size_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  At(handle).impl.SetBacktraceLevel(log_level);
+}
+
+void ContextRegistry::SetBacktrace(const BacktraceConfig& config) {
+  std::scoped_lock lock{mutex_};
+  backtrace_ = config;
+  const auto size = size_.load(std::memory_order_relaxed);
+  for (ContextHandle handle{0}; handle < size; ++handle) {
+    ApplyBacktrace(At(handle).impl);
+  }
+}
+
+std::pair<std::size_t, std::size_t> ContextRegistry::Locate(ContextHandle handle) {
+  // chunk i starts at handle kFirstChunkSize * (2^i - 1)
+  const auto chunk = static_cast<std::size_t>(std::bit_width(handle / kFirstChunkSize + 1) - 1);
+  return {chunk, handle - kFirstChunkSize * ((std::size_t{1} << chunk) - 1)};
+}
+
+ContextRegistry::Context& ContextRegistry::At(ContextHandle handle) {
+  const auto [chunk, position] = Locate(handle);
+  return *chunks_[chunk][position];
+}
+
+void ContextRegistry::Insert(Index& index, ContextHandle handle) {
+  const auto mask = index.size() - 1;
+  for (auto slot = std::hash<core::StringView>{}(At(handle).impl.ctx_id) & mask;; slot = (slot + 1) & mask) {
+    if (index[slot].load(std::memory_order_relaxed) == 0) {
+      // pairs with the acquire load in Find(), which then sees the context
+      index[slot].store(handle + 1, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+void ContextRegistry::Route(Logger::Impl& impl) const {
+  // the rules naming the context, if there are any, replace those for all contexts
+  const bool named = std::any_of(routes_.begin(), routes_.end(),
+                                 [&impl](const RouteConfig& route) { return route.ctx_id == impl.ctx_id; });
+  const core::String no_context;
+  const auto& ctx_id = named ? impl.ctx_id : no_context;
+
+  Logger::Impl::LevelSinks level_sinks{};
+  for (auto level = static_cast<std::size_t>(LogLevel::kFatal); level < level_sinks.size(); ++level) {
+    if (routes_.empty()) {
+      level_sinks[level] = all_sinks_;
+      continue;
+    }
+    for (const auto& route : routes_) {
+      if (route.ctx_id == ctx_id && level <= static_cast<std::size_t>(route.level)) {
+        level_sinks[level] |= route.sinks;
+      }
+    }
+  }
+  impl.Route(level_sinks);
+}
+
+void ContextRegistry::ApplyBacktrace(Logger::Impl& impl) const {
+  if (backtrace_.contexts.empty() ||
+      std::find(backtrace_.contexts.begin(), backtrace_.contexts.end(), impl.ctx_id) != backtrace_.contexts.end()) {
+    impl.SetBacktraceLevel(backtrace_.level);
+  }
+}
+}  // namespace ara::log
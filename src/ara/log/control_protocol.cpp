@@ -0,0 +1,178 @@
+#include "ara/log/control_protocol.h"
+
+#include "ara/core/optional.h"
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_error_domain.h"
+
+namespace {
+using ara::log::dlt::MessageInfo;
+
+/// @brief Write a control message: the base header and the payload written by write_payload.
+template <typename WritePayload>
+ara::core::Vector<ara::core::Byte> Encode(MessageInfo::ControlMessageInfo info, WritePayload&& write_payload) {
+  using ara::log::dlt::BaseHeader;
+  using ara::log::dlt::ByteWriter;
+  using ara::log::dlt::HeaderType;
+
+  ara::core::Vector<ara::core::Byte> message(ara::log::control::kMaxMessageSize);
+  const auto base_header = BaseHeader::ControlBaseHeader(HeaderType::ControlMode(), MessageInfo::ControlMessage(info));
+  const auto header_size = base_header.SerializedSize();
+  ByteWriter payload{ara::core::Span<ara::core::Byte>{message}.subspan(header_size)};
+  write_payload(payload);
+  ByteWriter header{message};
+  base_header.Serialize(header, static_cast<std::uint16_t>(header_size + payload.Size()), 0);
+  message.resize(header_size + payload.Size());
+  return message;
+}
+
+/// @brief Check the base header of a control message and return a reader positioned at the service id.
+ara::core::Optional<ara::log::dlt::ByteReader> Decode(ara::core::Span<const ara::core::Byte> message,
+                                                       MessageInfo::ControlMessageInfo info) {
+  using ara::log::dlt::HeaderType;
+
+  ara::log::dlt::ByteReader reader{message};
+  const auto header_type = reader.Read<std::uint32_t>();
+  // the message counter is not used by the control channel
+  reader.Read<std::uint8_t>();
+  const auto length = reader.Read<std::uint16_t>();
+  const auto message_info = reader.Read<std::uint8_t>();
+  const auto number_of_arguments = reader.Read<std::uint8_t>();
+  if (!number_of_arguments || *header_type != HeaderType::ControlMode().Value() || *length != message.size() ||
+      *message_info != MessageInfo::ControlMessage(info).Value()) {
+    return std::nullopt;
+  }
+  return reader;
+}
+
+ara::core::Optional<ara::log::LogLevel> ToLogLevel(ara::core::Optional<std::uint8_t> value) {
+  if (!value || *value > static_cast<std::uint8_t>(ara::log::LogLevel::kVerbose)) {
+    return std::nullopt;
+  }
+  return static_cast<ara::log::LogLevel>(*value);
+}
+}  // namespace
+
+namespace ara::log::control {
+core::Vector<core::Byte> Serialize(const Request& request) {
+  return Encode(MessageInfo::ControlMessageInfo::kRequest, [&request](dlt::ByteWriter& writer) {
+    writer.Write(static_cast<std::uint32_t>(request.service));
+    switch (request.service) {
+      case ServiceId::kSetLogLevel:
+        writer.WriteString(request.app_id);
+        writer.WriteString(request.ctx_id);
+        writer.Write(static_cast<std::uint8_t>(request.log_level));
+        break;
+      case ServiceId::kGetLogInfo:
+        writer.WriteString(request.app_id);
+        writer.WriteString(request.ctx_id);
+        break;
+      case ServiceId::kSetDefaultLogLevel:
+        writer.Write(static_cast<std::uint8_t>(request.log_level));
+        break;
+      default:
+        break;
+    }
+  });
+}
+
+core::Vector<core::Byte> Serialize(const Response& response) {
+  return Encode(MessageInfo::ControlMessageInfo::kResponse, [&response](dlt::ByteWriter& writer) {
+    writer.Write(static_cast<std::uint32_t>(response.service));
+    writer.Write(static_cast<std::uint8_t>(response.status));
+    if (response.status != Status::kOk) {
+      return;
+    }
+    if (response.service == ServiceId::kGetDefaultLogLevel) {
+      writer.Write(static_cast<std::uint8_t>(response.log_level));
+    } else if (response.service == ServiceId::kGetLogInfo) {
+      writer.WriteString(response.app_id);
+      // the count is written once it is known which contexts fit
+      auto count_writer = writer;
+      writer.Write(std::uint16_t{0});
+      std::uint16_t count{0};
+      // leave room for the base header
+      constexpr std::size_t kMaxPayloadSize{kMaxMessageSize - 16};
+      for (const auto& context : response.contexts) {
+        const auto size = dlt::ByteWriter::StringSize(context.ctx_id) + sizeof(std::uint8_t) +
+                          dlt::ByteWriter::StringSize(context.description);
+        if (writer.Size() + size > kMaxPayloadSize) {
+          break;
+        }
+        writer.WriteString(context.ctx_id);
+        writer.Write(static_cast<std::uint8_t>(context.log_level));
+        writer.WriteString(context.description);
+        ++count;
+      }
+      count_writer.Write(count);
+    }
+  });
+}
+
+core::Result<Request> ParseRequest(core::Span<const core::Byte> message) {
+  using R = core::Result<Request>;
+
+  auto reader = Decode(message, MessageInfo::ControlMessageInfo::kRequest);
+  const auto service = reader ? reader->Read<std::uint32_t>() : std::nullopt;
+  if (!service) {
+    return R::FromError(LogErrc::kInvalidControlMessage);
+  }
+  Request request{static_cast<ServiceId>(*service)};
+  if (request.service == ServiceId::kSetLogLevel || request.service == ServiceId::kGetLogInfo) {
+    const auto app_id = reader->ReadString();
+    const auto ctx_id = reader->ReadString();
+    if (!app_id || !ctx_id) {
+      return R::FromError(LogErrc::kInvalidControlMessage);
+    }
+    request.app_id = *app_id;
+    request.ctx_id = *ctx_id;
+  }
+  if (request.service == ServiceId::kSetLogLevel || request.service == ServiceId::kSetDefaultLogLevel) {
+    const auto log_level = ToLogLevel(reader->Read<std::uint8_t>());
+    if (!log_level) {
+      return R::FromError(LogErrc::kInvalidControlMessage);
+    }
+    request.log_level = *log_level;
+  }
+  return R::FromValue(std::move(request));
+}
+
+core::Result<Response> ParseResponse(core::Span<const core::Byte> message) {
+  using R = core::Result<Response>;
+
+  auto reader = Decode(message, MessageInfo::ControlMessageInfo::kResponse);
+  const auto service = reader ? reader->Read<std::uint32_t>() : std::nullopt;
+  const auto status = reader ? reader->Read<std::uint8_t>() : std::nullopt;
+  if (!service || !status) {
+    return R::FromError(LogErrc::kInvalidControlMessage);
+  }
+  Response response{static_cast<ServiceId>(*service), static_cast<Status>(*status)};
+  if (response.status != Status::kOk) {
+    return R::FromValue(std::move(response));
+  }
+
+  if (response.service == ServiceId::kGetDefaultLogLevel) {
+    const auto log_level = ToLogLevel(reader->Read<std::uint8_t>());
+    if (!log_level) {
+      return R::FromError(LogErrc::kInvalidControlMessage);
+    }
+    response.log_level = *log_level;
+  } else if (response.service == ServiceId::kGetLogInfo) {
+    const auto app_id = reader->ReadString();
+    const auto count = reader->Read<std::uint16_t>();
+    if (!app_id || !count) {
+      return R::FromError(LogErrc::kInvalidControlMessage);
+    }
+    response.app_id = *app_id;
+    for (std::uint16_t i{0}; i < *count; ++i) {
+      const auto ctx_id = reader->ReadString();
+      const auto log_level = ToLogLevel(reader->Read<std::uint8_t>());
+      const auto description = reader->ReadString();
+      if (!ctx_id || !log_level || !description) {
+        return R::FromError(LogErrc::kInvalidControlMessage);
+      }
+      response.contexts.push_back(ContextInfo{core::String{*ctx_id}, *log_level, core::String{*description}});
+    }
+  }
+  return R::FromValue(std::move(response));
+}
+}  // namespace ara::log::control
@@ -0,0 +1,204 @@
+#include "ara/log/control_server.h"
+
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <thread>
+
+#include "ara/log/control_protocol.h"
+#include "ara/log/log_error_domain.h"
+#include "asio.hpp"
+
+namespace {
+using Protocol = asio::local::seq_packet_protocol;
+
+/// @brief A connected client; each packet it sends is one request, answered by one packet.
+struct Session {
+  explicit Session(Protocol::socket&& client) : connection{std::move(client)} {}
+
+  Protocol::socket connection;
+  ara::core::Vector<ara::core::Byte> request = ara::core::Vector<ara::core::Byte>(ara::log::control::kMaxMessageSize);
+  ara::core::Vector<ara::core::Byte> response;
+  asio::socket_base::message_flags flags{0};
+};
+
+/// @brief Remove a socket left behind by an earlier run, which would make bind fail. Anything else at path is kept:
+/// a file that is no socket, or the socket of an instance still running, which is told apart by accepting connections.
+/// @return whether path is free to bind
+bool RemoveStaleSocket(const ara::core::String& path) {
+  struct stat status {};
+  if (::lstat(path.c_str(), &status) != 0) {
+    return errno == ENOENT;
+  }
+  if (!S_ISSOCK(status.st_mode)) {
+    return false;
+  }
+  asio::io_context io;
+  Protocol::socket probe{io};
+  asio::error_code error;
+  probe.connect(Protocol::endpoint{path}, error);
+  return error == asio::error::connection_refused && ::unlink(path.c_str()) == 0;
+}
+}  // namespace
+
+namespace ara::log {
+struct ControlServer::Impl {
+  Impl(const ControlConfig& control_config, ContextRegistry& context_registry)
+      : config{control_config}, contexts{context_registry}, acceptor{io} {}
+
+  bool Listen();
+  void Run();
+  void Stop();
+
+  void Accept();
+  void Receive(std::shared_ptr<Session> session);
+  void Respond(std::shared_ptr<Session> session, std::size_t request_size);
+  control::Response Serve(const control::Request& request);
+
+  const ControlConfig config;
+  ContextRegistry& contexts;
+  asio::io_context io;
+  Protocol::acceptor acceptor;
+  /// @brief whether the socket at config.path is ours, and to be removed by Stop()
+  bool bound{false};
+  std::thread thread;
+};
+
+bool ControlServer::Impl::Listen() {
+  if (!RemoveStaleSocket(config.path)) {
+    return false;
+  }
+  asio::error_code error;
+  acceptor.open(Protocol{}, error);
+  if (!error) {
+    acceptor.bind(Protocol::endpoint{config.path}, error);
+    bound = !error;
+  }
+  // changing levels is for the owner of the process and its group only; restricted before listening, since a
+  // connection made with looser permissions would stay usable
+  if (!error && ::chmod(config.path.c_str(), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP) != 0) {
+    return false;
+  }
+  if (!error) {
+    acceptor.listen(asio::socket_base::max_listen_connections, error);
+  }
+  return !error;
+}
+
+void ControlServer::Impl::Run() {
+  Accept();
+  thread = std::thread{[this]() { io.run(); }};
+  pthread_setname_np(thread.native_handle(), "ara_log_ctl");
+}
+
+void ControlServer::Impl::Stop() {
+  if (thread.joinable()) {
+    io.stop();
+    thread.join();
+  }
+  if (acceptor.is_open()) {
+    acceptor.close();
+  }
+  if (bound) {
+    ::unlink(config.path.c_str());
+  }
+}
+
+void ControlServer::Impl::Accept() {
+  acceptor.async_accept([this](const asio::error_code& error, Protocol::socket client) {
+    if (error == asio::error::operation_aborted) {
+      return;
+    }
+    if (!error) {
+      Receive(std::make_shared<Session>(std::move(client)));
+    }
+    Accept();
+  });
+}
+
+void ControlServer::Impl::Receive(std::shared_ptr<Session> session) {
+  auto& connection = session->connection;
+  connection.async_receive(asio::buffer(session->request), session->flags,
+                           [this, session](const asio::error_code& error, std::size_t size) {
+                             // the client closed the connection, or sent nothing but the end of it
+                             if (!error && size != 0) {
+                               Respond(session, size);
+                             }
+                           });
+}
+
+void ControlServer::Impl::Respond(std::shared_ptr<Session> session, std::size_t request_size) {
+  const auto request = control::ParseRequest({session->request.data(), request_size});
+  session->response = request ? control::Serialize(Serve(request.Value()))
+                              : control::Serialize(control::Response{control::ServiceId{0}, control::Status::kError});
+  auto& connection = session->connection;
+  connection.async_send(asio::buffer(session->response), 0,
+                        [this, session](const asio::error_code& error, std::size_t) {
+                          if (!error) {
+                            Receive(session);
+                          }
+                        });
+}
+
+control::Response ControlServer::Impl::Serve(const control::Request& request) {
+  using control::ServiceId;
+  using control::Status;
+
+  control::Response response{request.service};
+  const auto& app_id = LogConfig::Instance().AppId();
+  const auto addressed = [&request, &app_id](core::StringView ctx_id) {
+    return (request.app_id.empty() || request.app_id == app_id) && (request.ctx_id.empty() || request.ctx_id == ctx_id);
+  };
+
+  switch (request.service) {
+    case ServiceId::kSetLogLevel: {
+      bool found{false};
+      for (ContextHandle handle{0}; handle < contexts.Size(); ++handle) {
+        if (const auto context = contexts.Info(handle); context && addressed(context->ctx_id)) {
+          contexts.SetThreshold(handle, request.log_level);
+          found = true;
+        }
+      }
+      response.status = found ? Status::kOk : Status::kError;
+      break;
+    }
+    case ServiceId::kGetLogInfo:
+      response.app_id = app_id;
+      for (ContextHandle handle{0}; handle < contexts.Size(); ++handle) {
+        if (const auto context = contexts.Info(handle); context && addressed(context->ctx_id)) {
+          response.contexts.push_back(
+              control::ContextInfo{core::String{context->ctx_id}, context->threshold, core::String{context->ctx_desc}});
+        }
+      }
+      break;
+    case ServiceId::kGetDefaultLogLevel:
+      response.log_level = contexts.DefaultThreshold();
+      break;
+    case ServiceId::kSetDefaultLogLevel:
+      contexts.SetDefaultThreshold(request.log_level);
+      break;
+    default:
+      response.status = Status::kNotSupported;
+      break;
+  }
+  return response;
+}
+
+core::Result<std::unique_ptr<ControlServer>> ControlServer::Open(const ControlConfig& config,
+                                                                  ContextRegistry& contexts) {
+  using R = core::Result<std::unique_ptr<ControlServer>>;
+  auto server = std::make_unique<ControlServer>(config, contexts);
+  if (!server->impl_->Listen()) {
+    return R::FromError(LogErrc::kOpenControlChannelFailed);
+  }
+  server->impl_->Run();
+  return R::FromValue(std::move(server));
+}
+
+ControlServer::ControlServer(const ControlConfig& config, ContextRegistry& contexts)
+    : impl_{std::make_unique<Impl>(config, contexts)} {}
+
+ControlServer::~ControlServer() { impl_->Stop(); }
+}  // namespace ara::log
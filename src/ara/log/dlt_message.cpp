@@ -2,18 +2,22 @@
 
 #include <syscall.h>
 
-#include <cassert>
-#include <chrono>
+#include <array>
+#include <ctime>
+#include <limits>
 
 #include "ara/core/string_view.h"
 #include "ara/log/common.h"
+#include "ara/log/log_clock.h"
 #include "ara/log/log_config.h"
-#include "fmt/chrono.h"
+#include "ara/log/log_error_domain.h"
 #include "fmt/core.h"
+#include "fmt/ranges.h"
 #include "fmt/std.h"
 
 namespace {
-constexpr ara::core::StringView kTextFormat{"{time}|{ecu_id}|{app_id}|{ctx_id}|{thread_id}|{log_level}|"};
+/// @brief the fields following the time: ecu id, app id, ctx id, thread id and log level
+constexpr ara::core::StringView kTextFormat{"|{}|{}|{}|{}|{}|"};
 
 ara::core::StringView LogLevelToString(ara::log::LogLevel log_level) {
   switch (log_level) {
@@ -36,62 +40,176 @@ ara::core::StringView LogLevelToString(ara::log::LogLevel log_level) {
   }
 }
 
-std::int64_t GetSignedInteger(std::uint32_t type_info, const ara::core::Vector<ara::core::Byte>& bytes) {
-  if ((type_info & 0xF) == 0x01) {
-    return *reinterpret_cast<const std::int8_t*>(bytes.data());
-  }
-  if ((type_info & 0xF) == 0x02) {
-    return *reinterpret_cast<const std::int16_t*>(bytes.data());
+constexpr std::uint64_t kNanosecondsPerSecond{1'000'000'000};
+
+/// @brief "00" to "99" back to back, so that two decimal digits are written with one lookup
+constexpr auto kDigitPairs = [] {
+  std::array<char, 200> pairs{};
+  for (std::size_t i{0}; i < 100; ++i) {
+    pairs[i * 2] = static_cast<char>('0' + i / 10);
+    pairs[i * 2 + 1] = static_cast<char>('0' + i % 10);
   }
-  if ((type_info & 0xF) == 0x03) {
-    return *reinterpret_cast<const std::int32_t*>(bytes.data());
+  return pairs;
+}();
+
+/// @brief Write value (< 100) as two decimal digits.
+void WriteDigitPair(char* out, std::uint32_t value) { std::memcpy(out, &kDigitPairs[value * 2], 2); }
+
+/// @brief The rendered "YYYY-MM-DD HH:MM:SS." prefix of the last second seen by a thread.
+/// Consecutive messages mostly fall into the same second, so localtime_r (and the TZ lock it takes) runs about once
+/// per second per rendering thread instead of once per message.
+class CalendarCache {
+ public:
+  static constexpr std::size_t kPrefixSize{20};
+
+  const std::array<char, kPrefixSize>& Prefix(std::time_t seconds) {
+    if (seconds != seconds_) {
+      Update(seconds);
+    }
+    return prefix_;
   }
-  if ((type_info & 0xF) == 0x04) {
-    return *reinterpret_cast<const std::int64_t*>(bytes.data());
+
+ private:
+  void Update(std::time_t seconds) {
+    std::tm tm{};
+    localtime_r(&seconds, &tm);
+    const auto year = static_cast<std::uint32_t>(tm.tm_year + 1900) % 10000;
+    auto* out = prefix_.data();
+    WriteDigitPair(out, year / 100);
+    WriteDigitPair(out + 2, year % 100);
+    out[4] = '-';
+    WriteDigitPair(out + 5, tm.tm_mon + 1);
+    out[7] = '-';
+    WriteDigitPair(out + 8, tm.tm_mday);
+    out[10] = ' ';
+    WriteDigitPair(out + 11, tm.tm_hour);
+    out[13] = ':';
+    WriteDigitPair(out + 14, tm.tm_min);
+    out[16] = ':';
+    // tm_sec may be 60 on a leap second
+    WriteDigitPair(out + 17, tm.tm_sec);
+    out[19] = '.';
+    seconds_ = seconds;
   }
 
-  assert(false);
+ private:
+  std::time_t seconds_{-1};
+  std::array<char, kPrefixSize> prefix_{};
+};
+
+template <typename T>
+T Load(ara::core::Span<const ara::core::Byte> bytes) {
+  T value;
+  std::memcpy(&value, bytes.data(), sizeof value);
+  return ara::log::dlt::LittleEndian(value);
 }
 
-std::uint64_t GetUnsignedInteger(std::uint32_t type_info, const ara::core::Vector<ara::core::Byte>& bytes) {
-  if ((type_info & 0xF) == 0x01) {
-    return *reinterpret_cast<const std::uint8_t*>(bytes.data());
-  }
-  if ((type_info & 0xF) == 0x02) {
-    return *reinterpret_cast<const std::uint16_t*>(bytes.data());
-  }
-  if ((type_info & 0xF) == 0x03) {
-    return *reinterpret_cast<const std::uint32_t*>(bytes.data());
+void FormatValue(ara::core::String& out, const ara::log::dlt::Payload::ValueType& value) {
+  std::visit(
+      [&out](auto value) {
+        if constexpr (std::is_same_v<decltype(value), ara::core::Span<const ara::core::Byte>>) {
+          for (const auto byte : value) {
+            fmt::format_to(std::back_inserter(out), "{:02x}", std::to_integer<std::uint8_t>(byte));
+          }
+        } else {
+          fmt::format_to(std::back_inserter(out), "{}", value);
+        }
+      },
+      value);
+}
+
+/// @brief Append an integer in the base of format, with at least format.precision digits.
+void FormatInteger(ara::core::String& out, std::uint64_t magnitude, bool negative, ara::log::Format format) {
+  if (negative) {
+    out += '-';
   }
-  if ((type_info & 0xF) == 0x04) {
-    return *reinterpret_cast<const std::uint64_t*>(bytes.data());
+  const auto digits = std::max<std::uint16_t>(format.precision, 1);
+  switch (format.fmt) {
+    case ara::log::Fmt::kOct:
+      fmt::format_to(std::back_inserter(out), "0{:0{}o}", magnitude, digits);
+      break;
+    case ara::log::Fmt::kHex:
+      fmt::format_to(std::back_inserter(out), "0x{:0{}x}", magnitude, digits);
+      break;
+    case ara::log::Fmt::kBin:
+      fmt::format_to(std::back_inserter(out), "0b{:0{}b}", magnitude, digits);
+      break;
+    default:
+      fmt::format_to(std::back_inserter(out), "{:0{}d}", magnitude, digits);
+      break;
   }
+}
 
-  assert(false);
+/// @brief Append a floating point value in the notation of format.
+/// With the precision of the *FloatMax() formats, the value is written with as many digits as a round trip needs.
+template <typename T>
+void FormatFloat(ara::core::String& out, T value, ara::log::Format format) {
+  const auto max = format.precision == ara::log::detail::kMaxFloatPrecision;
+  constexpr auto kRoundTripDigits = std::numeric_limits<T>::max_digits10;
+  switch (format.fmt) {
+    case ara::log::Fmt::kDecFloat:
+      if (max) {
+        fmt::format_to(std::back_inserter(out), "{}", value);
+      } else {
+        fmt::format_to(std::back_inserter(out), "{:.{}f}", value, format.precision);
+      }
+      break;
+    case ara::log::Fmt::kEngFloat:
+      fmt::format_to(std::back_inserter(out), "{:.{}e}", value, max ? kRoundTripDigits - 1 : format.precision);
+      break;
+    case ara::log::Fmt::kHexFloat:
+      if (max) {
+        fmt::format_to(std::back_inserter(out), "{:a}", value);
+      } else {
+        fmt::format_to(std::back_inserter(out), "{:.{}a}", value, format.precision);
+      }
+      break;
+    default:
+      fmt::format_to(std::back_inserter(out), "{:.{}g}", value, max ? kRoundTripDigits : format.precision);
+      break;
+  }
 }
 
-double GetFloat(std::uint32_t type_info, const ara::core::Vector<ara::core::Byte>& bytes) {
-  if ((type_info & 0xF) == 0x03) {
-    return *reinterpret_cast<const float*>(bytes.data());
+/// @brief Append an argument as "name=value unit", leaving out what it has not got, with format applied to integers
+/// and floating point values it suits.
+void FormatArgument(ara::core::String& out, const ara::log::dlt::Payload::Argument& argument,
+                    ara::log::Format format) {
+  using ara::log::Fmt;
+  using ara::log::dlt::Payload;
+
+  if (!argument.name.empty()) {
+    out.append(argument.name);
+    out += '=';
   }
-  if ((type_info & 0xF) == 0x04) {
-    return *reinterpret_cast<const double*>(bytes.data());
+  const auto value = argument.GetValue();
+  const auto integer_format = format.fmt >= Fmt::kDec && format.fmt <= Fmt::kBin;
+  const auto float_format = format.fmt >= Fmt::kDecFloat && format.fmt <= Fmt::kAutoFloat;
+  if (const auto* unsigned_value = std::get_if<std::uint64_t>(&value); unsigned_value && integer_format) {
+    FormatInteger(out, *unsigned_value, false, format);
+  } else if (const auto* signed_value = std::get_if<std::int64_t>(&value); signed_value && integer_format) {
+    const auto magnitude = static_cast<std::uint64_t>(*signed_value);
+    FormatInteger(out, *signed_value < 0 ? 0 - magnitude : magnitude, *signed_value < 0, format);
+  } else if (const auto* float_value = std::get_if<double>(&value); float_value && float_format) {
+    if ((argument.type_info & Payload::kTypeLengthMask) == 3U) {
+      FormatFloat(out, static_cast<float>(*float_value), format);
+    } else {
+      FormatFloat(out, *float_value, format);
+    }
+  } else {
+    FormatValue(out, value);
+  }
+  if (!argument.unit.empty()) {
+    out += ' ';
+    out.append(argument.unit);
   }
-
-  assert(false);
 }
 }  // namespace
 
 namespace ara::log::dlt {
-thread_local std::int64_t Message::thread_id_{syscall(SYS_gettid)};
 std::atomic_uint8_t BaseHeader::message_counter_{0};
 constexpr std::uint8_t kVersionNumber{2};
 
-HeaderType::HeaderType() {
-  value_[5] = (kVersionNumber >> 0) & 1;
-  value_[6] = (kVersionNumber >> 1) & 1;
-  value_[7] = (kVersionNumber >> 2) & 1;
-}
+HeaderType::HeaderType() : value_{static_cast<std::uint32_t>(kVersionNumber) << kVersOffset} {}
 
 HeaderType HeaderType::VerboseMode() {
   HeaderType header_type;
@@ -107,46 +225,53 @@ HeaderType HeaderType::VerboseMode() {
   return header_type;
 }
 
-void HeaderType::SetContentInfo(Cnti cnti) {
-  value_[0] = (static_cast<std::uint8_t>(cnti) >> 0) & 1;
-  value_[1] = (static_cast<std::uint8_t>(cnti) >> 1) & 1;
+HeaderType HeaderType::NonVerboseMode() {
+  HeaderType header_type;
+  header_type.SetContentInfo(Cnti::kNonVerboseModeDataMessage);
+  return header_type;
 }
 
-HeaderType::Cnti HeaderType::GetContentInfo() const {
-  std::uint8_t cnti{0};
-  cnti |= value_[0] << 0;
-  cnti |= value_[1] << 1;
-
-  return static_cast<Cnti>(cnti);
+HeaderType HeaderType::ControlMode() {
+  HeaderType header_type;
+  header_type.SetContentInfo(Cnti::kControlMessage);
+  return header_type;
 }
 
-void HeaderType::SetWithEcuId(const bool with) { value_[2] = with; }
+void HeaderType::SetContentInfo(Cnti cnti) { value_ = (value_ & ~kCntiMask) | (static_cast<std::uint32_t>(cnti) & kCntiMask); }
+
+HeaderType::Cnti HeaderType::GetContentInfo() const { return static_cast<Cnti>(value_ & kCntiMask); }
+
+void HeaderType::SetWithEcuId(const bool with) { SetFlag(kWeid, with); }
 
-bool HeaderType::GetWithEcuId() const { return value_[2]; }
+bool HeaderType::GetWithEcuId() const { return value_ & kWeid; }
 
-void HeaderType::SetWithAppAndCtxId(const bool with) { value_[3] = with; }
+void HeaderType::SetWithAppAndCtxId(const bool with) { SetFlag(kWacid, with); }
 
-bool HeaderType::GetWithAppAndCtxId() const { return value_[3]; }
+bool HeaderType::GetWithAppAndCtxId() const { return value_ & kWacid; }
 
-void HeaderType::SetWithSessionId(const bool with) { value_[4] = with; }
+void HeaderType::SetWithSessionId(const bool with) { SetFlag(kWsid, with); }
 
-bool HeaderType::GetWithSessionId() const { return value_[4]; }
+bool HeaderType::GetWithSessionId() const { return value_ & kWsid; }
 
-void HeaderType::SetWithSourceFileNameAndLine(const bool with) { value_[8] = with; }
+void HeaderType::SetWithSourceFileNameAndLine(const bool with) { SetFlag(kWsfln, with); }
 
-bool HeaderType::GetWithSourceFileNameAndLine() const { return value_[8]; }
+bool HeaderType::GetWithSourceFileNameAndLine() const { return value_ & kWsfln; }
 
-void HeaderType::SetWithTags(const bool with) { value_[9] = with; }
+void HeaderType::SetWithTags(const bool with) { SetFlag(kWtgs, with); }
 
-bool HeaderType::GetWithTags() const { return value_[9]; }
+bool HeaderType::GetWithTags() const { return value_ & kWtgs; }
 
-void HeaderType::SetWithPrivacyLevel(const bool with) { value_[10] = with; }
+void HeaderType::SetWithPrivacyLevel(const bool with) { SetFlag(kWpvl, with); }
 
-bool HeaderType::GetWithPrivacyLevel() const { return value_[10]; }
+bool HeaderType::GetWithPrivacyLevel() const { return value_ & kWpvl; }
 
-void HeaderType::SetWithSegmentation(const bool with) { value_[11] = with; }
+void HeaderType::SetWithSegmentation(const bool with) { SetFlag(kWsgm, with); }
 
-bool HeaderType::GetWithSegmentation() const { return value_[11]; }
+bool HeaderType::GetWithSegmentation() const { return value_ & kWsgm; }
+
+std::uint32_t HeaderType::Value() const { return value_; }
+
+void HeaderType::SetFlag(std::uint32_t flag, bool with) { value_ = with ? (value_ | flag) : (value_ & ~flag); }
 
 MessageInfo MessageInfo::LogMessage(LogLevel log_level) {
   return MessageInfo{MessageType::kLog, static_cast<std::uint8_t>(log_level)};
@@ -160,32 +285,43 @@ MessageInfo MessageInfo::NetworkMessage(NetworkMessageInfo network_info) {
   return MessageInfo{MessageType::kNetwork, static_cast<std::uint8_t>(network_info)};
 }
 
-LogLevel MessageInfo::GetLogLevel() const {
-  return static_cast<LogLevel>(value_[7] << 3 | value_[6] << 2 | value_[5] << 1 | value_[4]);
+MessageInfo MessageInfo::ControlMessage(ControlMessageInfo control_info) {
+  return MessageInfo{MessageType::kControl, static_cast<std::uint8_t>(control_info)};
 }
 
-MessageInfo::MessageInfo(MessageType message_type, std::uint8_t const message_type_info) {
-  value_[1] = (static_cast<uint8_t>(message_type) >> 0) & 1;
-  value_[2] = (static_cast<uint8_t>(message_type) >> 1) & 1;
-  value_[3] = (static_cast<uint8_t>(message_type) >> 2) & 1;
+LogLevel MessageInfo::GetLogLevel() const { return static_cast<LogLevel>(value_ >> kMtinOffset); }
 
-  value_[4] = (message_type_info >> 0) & 1;
-  value_[5] = (message_type_info >> 1) & 1;
-  value_[6] = (message_type_info >> 2) & 1;
-  value_[7] = (message_type_info >> 3) & 1;
-}
+std::uint8_t MessageInfo::Value() const { return value_; }
+
+MessageInfo::MessageInfo(MessageType message_type, std::uint8_t const message_type_info)
+    : value_{static_cast<std::uint8_t>((static_cast<std::uint8_t>(message_type) & 0x7U) << kMstpOffset |
+                                       (message_type_info & 0xFU) << kMtinOffset)} {}
+
+Timestamp::Timestamp() : raw_{TimeSource::Instance().Now()} {}
+
+void Timestamp::FormatTo(core::String& out) const {
+  thread_local CalendarCache calendar_cache;
+  const auto realtime = TimeSource::Instance().ToRealtime(raw_);
+  const auto& prefix = calendar_cache.Prefix(static_cast<std::time_t>(realtime / kNanosecondsPerSecond));
 
-Timestamp::Timestamp() {
-  const auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-      std::chrono::high_resolution_clock::now().time_since_epoch());
-  nanoseconds_ = now_ns.count() % 1'000'000'000;
-  seconds_ = now_ns.count() / 1'000'000'000;
+  std::array<char, 9> nanoseconds;
+  auto value = static_cast<std::uint32_t>(realtime % kNanosecondsPerSecond);
+  for (std::size_t pair{0}; pair < 4; ++pair) {
+    WriteDigitPair(&nanoseconds[nanoseconds.size() - 2 * (pair + 1)], value % 100);
+    value /= 100;
+  }
+  nanoseconds[0] = static_cast<char>('0' + value);
+
+  out.append(prefix.data(), prefix.size());
+  out.append(nanoseconds.data(), nanoseconds.size());
+}
 
-  // TODO set mask
+std::uint32_t Timestamp::Nanoseconds() const {
+  return static_cast<std::uint32_t>(TimeSource::Instance().ToRealtime(raw_) % kNanosecondsPerSecond) & kNanosecondsMask;
 }
 
-const core::String Timestamp::ToString() const {
-  return fmt::format("{:%Y-%m-%d %H:%M:%S}.{:0>9}", fmt::localtime(seconds_), nanoseconds_);
+std::uint64_t Timestamp::Seconds() const {
+  return TimeSource::Instance().ToRealtime(raw_) / kNanosecondsPerSecond & kSecondsMask;
 }
 
 BaseHeader BaseHeader::VerboseModeLogBaseHeader(HeaderType&& header_type, LogLevel log_level) {
@@ -195,6 +331,22 @@ BaseHeader BaseHeader::VerboseModeLogBaseHeader(HeaderType&& header_type, LogLev
   return base_header;
 }
 
+BaseHeader BaseHeader::NonVerboseModeLogBaseHeader(HeaderType&& header_type, LogLevel log_level,
+                                                   std::uint32_t message_id) {
+  BaseHeader base_header{std::move(header_type)};
+  // not sent in non-verbose mode, but the handlers filter and flush by level
+  base_header.message_info_ = MessageInfo::LogMessage(log_level);
+  base_header.timestamp_ = Timestamp{};
+  base_header.msid_ = message_id;
+  return base_header;
+}
+
+BaseHeader BaseHeader::ControlBaseHeader(HeaderType&& header_type, MessageInfo message_info) {
+  BaseHeader base_header{std::move(header_type)};
+  base_header.message_info_ = message_info;
+  return base_header;
+}
+
 LogLevel BaseHeader::GetLogLevel() const {
   if (!message_info_) {
     return LogLevel::kOff;
@@ -203,12 +355,61 @@ LogLevel BaseHeader::GetLogLevel() const {
   return message_info_->GetLogLevel();
 }
 
-core::String BaseHeader::GetTimeStr() const {
-  if (!timestamp_) {
-    return {};
+void BaseHeader::FormatTimeTo(core::String& out) const {
+  if (timestamp_) {
+    timestamp_->FormatTo(out);
   }
+}
 
-  return timestamp_->ToString();
+HeaderType& BaseHeader::GetHeaderType() { return header_type_; }
+
+const HeaderType& BaseHeader::GetHeaderType() const { return header_type_; }
+
+std::size_t BaseHeader::SerializedSize() const {
+  // HTYP2, MCNT and LEN
+  std::size_t size{sizeof(std::uint32_t) + sizeof(std::uint8_t) + sizeof(std::uint16_t)};
+  switch (header_type_.GetContentInfo()) {
+    case HeaderType::Cnti::kVerboseModeDataMessage:
+      size += sizeof(std::uint8_t) + sizeof(std::uint8_t) + Timestamp::kSerializedSize;
+      break;
+    case HeaderType::Cnti::kNonVerboseModeDataMessage:
+      size += Timestamp::kSerializedSize + sizeof(std::uint32_t);
+      break;
+    case HeaderType::Cnti::kControlMessage:
+      size += sizeof(std::uint8_t) + sizeof(std::uint8_t);
+      break;
+    default:
+      break;
+  }
+  return size;
+}
+
+void BaseHeader::Serialize(ByteWriter& writer, std::uint16_t length, std::uint8_t number_of_arguments) const {
+  writer.Write(header_type_.Value());
+  writer.Write(this_counter_);
+  writer.Write(length);
+
+  const auto write_timestamp = [this, &writer]() {
+    writer.Write(timestamp_ ? timestamp_->Nanoseconds() : std::uint32_t{0});
+    writer.WriteUint40(timestamp_ ? timestamp_->Seconds() : std::uint64_t{0});
+  };
+  switch (header_type_.GetContentInfo()) {
+    case HeaderType::Cnti::kVerboseModeDataMessage:
+      writer.Write(message_info_ ? message_info_->Value() : std::uint8_t{0});
+      writer.Write(number_of_arguments);
+      write_timestamp();
+      break;
+    case HeaderType::Cnti::kNonVerboseModeDataMessage:
+      write_timestamp();
+      writer.Write(msid_.value_or(0));
+      break;
+    case HeaderType::Cnti::kControlMessage:
+      writer.Write(message_info_ ? message_info_->Value() : std::uint8_t{0});
+      writer.Write(number_of_arguments);
+      break;
+    default:
+      break;
+  }
 }
 
 BaseHeader::BaseHeader(HeaderType&& header_type) : header_type_{header_type} {}
@@ -249,69 +450,612 @@ core::StringView ExtensionHeader::CtxId() const {
   return *ctx_id_.value;
 }
 
-core::String Payload::ToString() const {
-  core::String str;
-  for (auto& arg : arguments_) {
-    std::visit([&str](auto value) { fmt::format_to(std::back_inserter(str), "{} ", value); }, arg.GetValue());
+void ExtensionHeader::SetSourceLocation(core::StringView file_name, std::uint32_t line_num) {
+  file_name_.desc = file_name.size();
+  file_name_.value = file_name;
+  line_num_ = line_num;
+}
+
+void ExtensionHeader::ClearSourceLocationAndTags() {
+  file_name_.desc.reset();
+  if (file_name_.value) {
+    file_name_.value->clear();
+  }
+  line_num_.reset();
+  tags_.desc.reset();
+  if (tags_.value) {
+    tags_.value->clear();
   }
-  return str;
 }
 
-Payload::Argument::ValueType Payload::Argument::GetValue() const {
-  if (type_info_ & (1 << kTypeBoolOffset)) {
-    return std::to_integer<bool>(data_payload_[0]);
+core::StringView ExtensionHeader::FileName() const {
+  if (!file_name_.value) {
+    return "";
   }
-  if (type_info_ & (1 << kTypeSignedOffset)) {
-    return GetSignedInteger(type_info_, data_payload_);
+  return *file_name_.value;
+}
+
+core::Optional<std::uint32_t> ExtensionHeader::LineNum() const { return line_num_; }
+
+void ExtensionHeader::AddTag(core::StringView tag) {
+  if (!tags_.value) {
+    tags_.value.emplace();
   }
-  if (type_info_ & (1 << kTypeUnsignedOffset)) {
-    return GetUnsignedInteger(type_info_, data_payload_);
+  tags_.value->emplace_back(tag);
+  tags_.desc = tags_.value->size();
+}
+
+const core::Vector<core::String>& ExtensionHeader::Tags() const {
+  static const core::Vector<core::String> kNoTags;
+  if (!tags_.value) {
+    return kNoTags;
   }
-  if (type_info_ & (1 << kTypeFloatOffset)) {
-    return GetFloat(type_info_, data_payload_);
+  return *tags_.value;
+}
+
+std::size_t ExtensionHeader::SerializedSize(const HeaderType& header_type) const {
+  const auto string_size = ByteWriter::StringSize;
+
+  std::size_t size{0};
+  if (header_type.GetWithEcuId()) {
+    size += string_size(EcuId());
+  }
+  if (header_type.GetWithAppAndCtxId()) {
+    size += string_size(AppId()) + string_size(CtxId());
+  }
+  if (header_type.GetWithSessionId()) {
+    size += sizeof(std::uint32_t);
+  }
+  if (header_type.GetWithSourceFileNameAndLine()) {
+    size += string_size(FileName()) + sizeof(std::uint32_t);
   }
-  if (type_info_ & (1 << kTypeStringOffset)) {
-    return core::StringView{reinterpret_cast<const char*>(data_payload_.data()), data_payload_.size()};
+  if (header_type.GetWithTags()) {
+    size += sizeof(std::uint8_t);
+    for (const auto& tag : Tags()) {
+      size += string_size(tag);
+    }
   }
+  return size;
+}
 
-  assert(false);
+void ExtensionHeader::Serialize(ByteWriter& writer, const HeaderType& header_type) const {
+  if (header_type.GetWithEcuId()) {
+    writer.WriteString(EcuId());
+  }
+  if (header_type.GetWithAppAndCtxId()) {
+    writer.WriteString(AppId());
+    writer.WriteString(CtxId());
+  }
+  if (header_type.GetWithSessionId()) {
+    writer.Write(session_id_.value_or(0));
+  }
+  if (header_type.GetWithSourceFileNameAndLine()) {
+    writer.WriteString(FileName());
+    writer.Write(line_num_.value_or(0));
+  }
+  if (header_type.GetWithTags()) {
+    writer.Write(static_cast<std::uint8_t>(Tags().size()));
+    for (const auto& tag : Tags()) {
+      writer.WriteString(tag);
+    }
+  }
+}
+
+core::Result<void> Payload::AddModeledArgument(ArgumentType type, core::Span<const core::Byte> value) {
+  if (type == ArgumentType::kString || type == ArgumentType::kRaw) {
+    const auto terminate = type == ArgumentType::kString;
+    // checked before narrowing to the 16 bit length field, which must not wrap
+    const std::size_t length{value.size() + (terminate ? 1 : 0)};
+    if (truncated_ || length > UINT16_MAX || !buffer_.Fits(sizeof(std::uint16_t) + length)) {
+      return Overflow();
+    }
+    buffer_.Append(LittleEndian(static_cast<std::uint16_t>(length)));
+    buffer_.Append(value);
+    if (terminate) {
+      buffer_.Append('\0');
+    }
+  } else {
+    if (truncated_ || !buffer_.Fits(value.size())) {
+      return Overflow();
+    }
+    std::array<core::Byte, sizeof(std::uint64_t)> bytes{};
+    std::copy(value.begin(), value.end(), bytes.begin());
+    if constexpr (std::endian::native == std::endian::big) {
+      std::reverse(bytes.begin(), bytes.begin() + value.size());
+    }
+    buffer_.Append(core::Span<const core::Byte>{bytes.data(), value.size()});
+  }
+  ++number_of_arguments_;
+  return {};
+}
+
+core::Result<void> Payload::AddArguments(const Payload& other) {
+  const auto data = other.Data();
+  if (truncated_ || !buffer_.Fits(data.size()) || number_of_arguments_ + other.number_of_arguments_ > UINT8_MAX) {
+    return Overflow();
+  }
+  buffer_.Append(data);
+  for (const auto& [index, format] : other.formats_) {
+    formats_.emplace_back(static_cast<std::uint8_t>(number_of_arguments_ + index), format);
+  }
+  number_of_arguments_ = static_cast<std::uint8_t>(number_of_arguments_ + other.number_of_arguments_);
+  truncated_ = other.truncated_;
+  return {};
+}
+
+void Payload::Assign(const Payload& other) {
+  Clear();
+  AddArguments(other);
+}
+
+void Payload::Clear() {
+  buffer_.Clear();
+  number_of_arguments_ = 0;
+  formats_.clear();
+  truncated_ = false;
+}
+
+std::uint8_t Payload::NumberOfArguments() const { return number_of_arguments_; }
+
+core::Span<const core::Byte> Payload::Data() const { return buffer_.Data(); }
+
+core::Optional<Payload::Argument> Payload::ReadArgument(std::size_t& offset) const {
+  const auto data = buffer_.Data();
+  if (offset + sizeof(std::uint32_t) > data.size()) {
+    return std::nullopt;
+  }
+
+  Argument argument{Load<std::uint32_t>(data.subspan(offset))};
+  const auto type_info = argument.type_info;
+  offset += sizeof type_info;
+
+  // the 16 bit lengths of the value (of strings and raw data), the name and the unit precede the name, unit and value
+  const auto variable_length = (type_info & (1U << kTypeStringOffset | 1U << kTypeRawOffset)) != 0;
+  const auto with_name = (type_info & 1U << kTypeVariableInfoOffset) != 0;
+  const auto with_unit =
+      with_name && (type_info & (1U << kTypeSignedOffset | 1U << kTypeUnsignedOffset | 1U << kTypeFloatOffset)) != 0;
+  std::array<std::size_t, 3> lengths{variable_length ? 0 : std::size_t{1} << ((type_info & kTypeLengthMask) - 1), 0,
+                                     0};
+  const std::array<bool, 3> with_length{variable_length, with_name, with_unit};
+  for (std::size_t i{0}; i < lengths.size(); ++i) {
+    if (with_length[i]) {
+      if (offset + sizeof(std::uint16_t) > data.size()) {
+        return std::nullopt;
+      }
+      lengths[i] = Load<std::uint16_t>(data.subspan(offset));
+      offset += sizeof(std::uint16_t);
+    }
+  }
+  if (offset + lengths[0] + lengths[1] + lengths[2] > data.size()) {
+    return std::nullopt;
+  }
+
+  const auto read_text = [&data, &offset](std::size_t length) {
+    // the terminating NUL is part of the encoded length
+    const core::StringView text{reinterpret_cast<const char*>(data.data() + offset), length == 0 ? 0 : length - 1};
+    offset += length;
+    return text;
+  };
+  argument.name = read_text(lengths[1]);
+  argument.unit = read_text(lengths[2]);
+  argument.data = data.subspan(offset, lengths[0]);
+  offset += lengths[0];
+  return argument;
+}
+
+void Payload::FormatTo(core::String& out) const {
+  std::size_t offset{0};
+  std::uint8_t index{0};
+  auto format = formats_.begin();
+  while (const auto argument = ReadArgument(offset)) {
+    if (format != formats_.end() && format->first == index) {
+      FormatArgument(out, *argument, format->second);
+      ++format;
+    } else {
+      FormatArgument(out, *argument, Format{Fmt::kDefault, 0});
+    }
+    ++index;
+    out += ' ';
+  }
+  if (truncated_) {
+    out += "... ";
+  }
+}
+
+void Payload::FormatModeledTo(core::String& out, const detail::ModeledMessageInfo& info) const {
+  const auto data = buffer_.Data();
+  std::size_t offset{0};
+  std::size_t index{0};
+  auto format = info.format;
+  for (auto pos = format.find("{}"); pos != core::StringView::npos; pos = format.find("{}")) {
+    out.append(format.data(), pos);
+    format.remove_prefix(pos + 2);
+    if (index >= number_of_arguments_) {
+      out += "...";
+      continue;
+    }
+
+    // modeled arguments are encoded like verbose ones, only without the type info
+    const auto type_info = TypeInfo(info.argument_types[index++]);
+    std::size_t length{0};
+    if (type_info & (1U << kTypeStringOffset | 1U << kTypeRawOffset)) {
+      length = Load<std::uint16_t>(data.subspan(offset));
+      offset += sizeof(std::uint16_t);
+    } else {
+      length = std::size_t{1} << ((type_info & kTypeLengthMask) - 1);
+    }
+    FormatValue(out, Argument{type_info, data.subspan(offset, length)}.GetValue());
+    offset += length;
+  }
+  out.append(format.data(), format.size());
+}
+
+core::Result<void> Payload::AppendVariable(std::uint32_t type_info, core::Span<const core::Byte> value, bool terminate) {
+  // checked before narrowing to the 16 bit length field, which must not wrap
+  const std::size_t length{value.size() + (terminate ? 1 : 0)};
+  if (truncated_ || length > UINT16_MAX || !buffer_.Fits(sizeof type_info + sizeof(std::uint16_t) + length)) {
+    return Overflow();
+  }
+  buffer_.Append(LittleEndian(type_info));
+  buffer_.Append(LittleEndian(static_cast<std::uint16_t>(length)));
+  buffer_.Append(value);
+  if (terminate) {
+    buffer_.Append('\0');
+  }
+  ++number_of_arguments_;
+  return {};
+}
+
+core::Result<void> Payload::AppendAttributed(std::uint32_t type_info, core::Span<const core::Byte> value,
+                                             const ArgumentAttributes& attributes) {
+  const core::StringView name{attributes.name ? attributes.name : ""};
+  const core::StringView unit{attributes.unit ? attributes.unit : ""};
+  // DLT has a unit for numeric arguments only
+  const auto with_name = attributes.name || attributes.unit;
+  const auto with_unit =
+      with_name && (type_info & (1U << kTypeSignedOffset | 1U << kTypeUnsignedOffset | 1U << kTypeFloatOffset)) != 0;
+  const auto variable_length = (type_info & (1U << kTypeStringOffset | 1U << kTypeRawOffset)) != 0;
+  const auto terminate = (type_info & 1U << kTypeStringOffset) != 0;
+  if (with_name) {
+    type_info |= 1U << kTypeVariableInfoOffset;
+  }
+  if (type_info & 1U << kTypeUnsignedOffset && attributes.format.fmt == Fmt::kHex) {
+    type_info |= kStringCodingHex << kStringCodingOffset;
+  } else if (type_info & 1U << kTypeUnsignedOffset && attributes.format.fmt == Fmt::kBin) {
+    type_info |= kStringCodingBin << kStringCodingOffset;
+  }
+
+  // checked before narrowing to the 16 bit length fields, which must not wrap
+  const std::size_t length{value.size() + (terminate ? 1 : 0)};
+  const std::size_t name_length{name.size() + 1};
+  const std::size_t unit_length{unit.size() + 1};
+  const auto size = sizeof type_info + (variable_length ? sizeof(std::uint16_t) : 0) +
+                    (with_name ? sizeof(std::uint16_t) + name_length : 0) +
+                    (with_unit ? sizeof(std::uint16_t) + unit_length : 0) + length;
+  if (truncated_ || length > UINT16_MAX || name_length > UINT16_MAX || unit_length > UINT16_MAX ||
+      !buffer_.Fits(size)) {
+    return Overflow();
+  }
+  buffer_.Append(LittleEndian(type_info));
+  if (variable_length) {
+    buffer_.Append(LittleEndian(static_cast<std::uint16_t>(length)));
+  }
+  if (with_name) {
+    buffer_.Append(LittleEndian(static_cast<std::uint16_t>(name_length)));
+  }
+  if (with_unit) {
+    buffer_.Append(LittleEndian(static_cast<std::uint16_t>(unit_length)));
+  }
+  if (with_name) {
+    buffer_.Append(name);
+    buffer_.Append('\0');
+  }
+  if (with_unit) {
+    buffer_.Append(unit);
+    buffer_.Append('\0');
+  }
+  buffer_.Append(value);
+  if (terminate) {
+    buffer_.Append('\0');
+  }
+  if (attributes.format.fmt != Fmt::kDefault) {
+    formats_.emplace_back(number_of_arguments_, attributes.format);
+  }
+  ++number_of_arguments_;
+  return {};
+}
+
+std::uint32_t Payload::TypeInfo(ArgumentType type) {
+  switch (type) {
+    case ArgumentType::kBool:
+      return TypeLength<std::uint8_t>() | 1U << kTypeBoolOffset;
+    case ArgumentType::kUint8:
+      return TypeLength<std::uint8_t>() | 1U << kTypeUnsignedOffset;
+    case ArgumentType::kUint16:
+      return TypeLength<std::uint16_t>() | 1U << kTypeUnsignedOffset;
+    case ArgumentType::kUint32:
+      return TypeLength<std::uint32_t>() | 1U << kTypeUnsignedOffset;
+    case ArgumentType::kUint64:
+      return TypeLength<std::uint64_t>() | 1U << kTypeUnsignedOffset;
+    case ArgumentType::kInt8:
+      return TypeLength<std::int8_t>() | 1U << kTypeSignedOffset;
+    case ArgumentType::kInt16:
+      return TypeLength<std::int16_t>() | 1U << kTypeSignedOffset;
+    case ArgumentType::kInt32:
+      return TypeLength<std::int32_t>() | 1U << kTypeSignedOffset;
+    case ArgumentType::kInt64:
+      return TypeLength<std::int64_t>() | 1U << kTypeSignedOffset;
+    case ArgumentType::kFloat32:
+      return TypeLength<float>() | 1U << kTypeFloatOffset;
+    case ArgumentType::kFloat64:
+      return TypeLength<double>() | 1U << kTypeFloatOffset;
+    case ArgumentType::kString:
+      return 1U << kTypeStringOffset | kStringCodingUtf8 << kStringCodingOffset;
+    default:
+      return 1U << kTypeRawOffset;
+  }
+}
+
+core::Result<void> Payload::Overflow() {
+  truncated_ = true;
+  return core::Result<void>::FromError(LogErrc::kBufferOverflow);
+}
+
+Payload::ValueType Payload::Argument::GetValue() const {
+  const auto length{type_info & kTypeLengthMask};
+  if (type_info & (1U << kTypeBoolOffset)) {
+    return data[0] != core::Byte{0};
+  }
+  if (type_info & (1U << kTypeSignedOffset)) {
+    switch (length) {
+      case 1U:
+        return std::int64_t{Load<std::int8_t>(data)};
+      case 2U:
+        return std::int64_t{Load<std::int16_t>(data)};
+      case 3U:
+        return std::int64_t{Load<std::int32_t>(data)};
+      default:
+        return Load<std::int64_t>(data);
+    }
+  }
+  if (type_info & (1U << kTypeUnsignedOffset)) {
+    switch (length) {
+      case 1U:
+        return std::uint64_t{Load<std::uint8_t>(data)};
+      case 2U:
+        return std::uint64_t{Load<std::uint16_t>(data)};
+      case 3U:
+        return std::uint64_t{Load<std::uint32_t>(data)};
+      default:
+        return Load<std::uint64_t>(data);
+    }
+  }
+  if (type_info & (1U << kTypeFloatOffset)) {
+    if (length == 3U) {
+      return double{Load<float>(data)};
+    }
+    return Load<double>(data);
+  }
+  if (type_info & (1U << kTypeStringOffset)) {
+    // the terminating NUL is part of the encoded length
+    return core::StringView{reinterpret_cast<const char*>(data.data()), data.empty() ? 0 : data.size() - 1};
+  }
+
+  return data;
 }
 
 std::shared_ptr<Message> Message::VerboseModeLogMessage(LogLevel log_level, core::StringView ctx_id) {
   auto msg_ptr = Create(BaseHeader::VerboseModeLogBaseHeader(HeaderType::VerboseMode(), log_level));
-  ExtensionHeader ext_header{};
-  ext_header.SetEcuId(LogConfig::Instance().EcuId());
-  ext_header.SetAppId(LogConfig::Instance().AppId());
-  ext_header.SetCtxId(ctx_id);
-  msg_ptr->ext_header_ = std::move(ext_header);
-  msg_ptr->payload_ = Payload{};
+  if (!msg_ptr->ext_header_) {
+    msg_ptr->ext_header_.emplace();
+  }
+  msg_ptr->ext_header_->SetEcuId(LogConfig::Instance().EcuId());
+  msg_ptr->ext_header_->SetAppId(LogConfig::Instance().AppId());
+  msg_ptr->ext_header_->SetCtxId(ctx_id);
+  if (!msg_ptr->payload_) {
+    msg_ptr->payload_.emplace();
+  }
+  return msg_ptr;
+}
+
+std::shared_ptr<Message> Message::NonVerboseModeLogMessage(const detail::ModeledMessageInfo& info,
+                                                           core::StringView ctx_id) {
+  auto msg_ptr =
+      Create(BaseHeader::NonVerboseModeLogBaseHeader(HeaderType::NonVerboseMode(), info.log_level, info.id));
+  // not sent, as the header type leaves them out, but shown when the message is rendered as text
+  if (!msg_ptr->ext_header_) {
+    msg_ptr->ext_header_.emplace();
+  }
+  msg_ptr->ext_header_->SetEcuId(LogConfig::Instance().EcuId());
+  msg_ptr->ext_header_->SetAppId(LogConfig::Instance().AppId());
+  msg_ptr->ext_header_->SetCtxId(ctx_id);
+  if (!msg_ptr->payload_) {
+    msg_ptr->payload_.emplace();
+  }
+  msg_ptr->modeled_info_ = &info;
   return msg_ptr;
 }
 
 Message::Message(ThisIsPrivateType, BaseHeader&& base_header) : base_header_{base_header} {}
 
+std::shared_ptr<Message> Message::Copy(const Message& other) {
+  auto message = Create(BaseHeader{other.base_header_});
+  message->Assign(other);
+  return message;
+}
+
+void Message::Assign(const Message& other) {
+  base_header_ = other.base_header_;
+  ext_header_ = other.ext_header_;
+  if (other.payload_) {
+    if (!payload_) {
+      payload_.emplace();
+    }
+    payload_->Assign(*other.payload_);
+  } else {
+    payload_.reset();
+  }
+  modeled_info_ = other.modeled_info_;
+  text_.clear();
+  has_text_ = false;
+  serialized_.clear();
+  has_serialized_ = false;
+  thread_id_ = other.thread_id_;
+  sinks_ = other.sinks_;
+}
+
 std::shared_ptr<Message> Message::Create(BaseHeader&& base_header) {
-  return std::make_shared<Message>(ThisIsPrivateType{}, std::move(base_header));
+  auto& pool = MessagePool::Local();
+  if (auto message = pool.Acquire()) {
+    message->Recycle(std::move(base_header));
+    return message;
+  }
+
+  auto message = std::make_shared<Message>(ThisIsPrivateType{}, std::move(base_header));
+  pool.Adopt(message);
+  return message;
+}
+
+void Message::Recycle(BaseHeader&& base_header) {
+  base_header_ = std::move(base_header);
+  if (ext_header_) {
+    ext_header_->ClearSourceLocationAndTags();
+  }
+  if (payload_) {
+    payload_->Clear();
+  }
+  modeled_info_ = nullptr;
+  text_.clear();
+  has_text_ = false;
+  serialized_.clear();
+  has_serialized_ = false;
+  thread_id_ = CurrentThreadId();
+  sinks_ = 0;
+}
+
+std::int64_t Message::CurrentThreadId() {
+  thread_local const std::int64_t thread_id{syscall(SYS_gettid)};
+  return thread_id;
+}
+
+void Message::SetSourceLocation(core::StringView file_name, std::uint32_t line_num) {
+  if (!ext_header_) {
+    ext_header_.emplace();
+  }
+  ext_header_->SetSourceLocation(file_name, line_num);
+  base_header_.GetHeaderType().SetWithSourceFileNameAndLine(true);
+}
+
+void Message::AddTag(core::StringView tag) {
+  if (!ext_header_) {
+    ext_header_.emplace();
+  }
+  ext_header_->AddTag(tag);
+  base_header_.GetHeaderType().SetWithTags(true);
+}
+
+LogLevel Message::GetLogLevel() const { return base_header_.GetLogLevel(); }
+
+core::StringView Message::CtxId() const { return ext_header_ ? ext_header_->CtxId() : core::StringView{}; }
+
+std::uint64_t Message::ContentHash() const {
+  // 64 bit FNV-1a
+  std::uint64_t hash{0xCBF2'9CE4'8422'2325};
+  const auto add = [&hash](core::Span<const core::Byte> bytes) {
+    for (const auto byte : bytes) {
+      hash = (hash ^ std::to_integer<std::uint64_t>(byte)) * 0x100'0000'01B3;
+    }
+  };
+  const auto ctx_id = CtxId();
+  add(std::as_bytes(core::Span<const char>{ctx_id.data(), ctx_id.size()}));
+  const std::array<std::uint32_t, 2> header{static_cast<std::uint32_t>(GetLogLevel()),
+                                            modeled_info_ ? modeled_info_->id : 0};
+  add(std::as_bytes(core::Span<const std::uint32_t>{header}));
+  if (payload_) {
+    add(payload_->Data());
+  }
+  return hash;
+}
+
+void Message::SetSinks(SinkMask sinks) { sinks_ = sinks; }
+
+SinkMask Message::Sinks() const { return sinks_; }
+
+std::size_t Message::SerializedSize() const {
+  std::size_t size{base_header_.SerializedSize()};
+  if (ext_header_) {
+    size += ext_header_->SerializedSize(base_header_.GetHeaderType());
+  }
+  if (payload_) {
+    size += payload_->Data().size();
+  }
+  return size;
+}
+
+core::Result<std::size_t> Message::SerializeTo(core::Span<core::Byte> out) const {
+  using R = core::Result<std::size_t>;
+
+  const auto size = SerializedSize();
+  if (size > out.size() || size > std::numeric_limits<std::uint16_t>::max()) {
+    return R::FromError(LogErrc::kBufferOverflow);
+  }
+
+  ByteWriter writer{out};
+  base_header_.Serialize(writer, static_cast<std::uint16_t>(size), payload_ ? payload_->NumberOfArguments() : 0);
+  if (ext_header_) {
+    ext_header_->Serialize(writer, base_header_.GetHeaderType());
+  }
+  if (payload_) {
+    writer.Write(payload_->Data());
+  }
+  return R::FromValue(writer.Size());
+}
+
+core::Span<const core::Byte> Message::Serialized() const {
+  if (has_serialized_) {
+    return serialized_;
+  }
+
+  has_serialized_ = true;
+  serialized_.resize(SerializedSize());
+  if (!SerializeTo(serialized_)) {
+    serialized_.clear();
+  }
+  return serialized_;
 }
 
 const core::String& Message::ToString() const {
-  if (text_) {
-    return text_.value();
+  if (has_text_) {
+    return text_;
   }
 
-  text_ =
-      fmt::format(kTextFormat, fmt::arg("time", base_header_.GetTimeStr()),
-                  fmt::arg("ecu_id", ext_header_ ? ext_header_->EcuId() : "UNKNOWN"),
-                  fmt::arg("app_id", ext_header_ ? ext_header_->AppId() : "UNKNOWN"),
-                  fmt::arg("ctx_id", ext_header_ ? ext_header_->CtxId() : "UNKNOWN"), fmt::arg("thread_id", thread_id_),
-                  fmt::arg("log_level", LogLevelToString(base_header_.GetLogLevel())));
+  has_text_ = true;
+  text_.clear();
+  base_header_.FormatTimeTo(text_);
+  fmt::format_to(std::back_inserter(text_), kTextFormat, ext_header_ ? ext_header_->EcuId() : "UNKNOWN",
+                 ext_header_ ? ext_header_->AppId() : "UNKNOWN", ext_header_ ? ext_header_->CtxId() : "UNKNOWN",
+                 thread_id_, LogLevelToString(base_header_.GetLogLevel()));
+
+  if (ext_header_ && ext_header_->LineNum()) {
+    fmt::format_to(std::back_inserter(text_), "{}:{}|", ext_header_->FileName(), *ext_header_->LineNum());
+  }
+
+  if (ext_header_ && !ext_header_->Tags().empty()) {
+    fmt::format_to(std::back_inserter(text_), "{}|", fmt::join(ext_header_->Tags(), ","));
+  }
 
   if (!payload_) {
-    return text_.value();
+    return text_;
+  }
+
+  if (modeled_info_) {
+    payload_->FormatModeledTo(text_, *modeled_info_);
+    return text_;
   }
 
-  fmt::format_to(std::back_inserter(*text_), "{} ", payload_->ToString());
-  return text_.value();
+  payload_->FormatTo(text_);
+  text_ += ' ';
+  return text_;
 }
 
 }  // namespace ara::log::dlt
\ No newline at end of file
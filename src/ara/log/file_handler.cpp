@@ -0,0 +1,192 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_error_domain.h"
+#include "ara/log/logging_handler.h"
+
+namespace {
+constexpr std::size_t kPageSize{4096};
+}
+
+namespace ara::log {
+FileHandler::OutputBuffer::OutputBuffer(std::size_t capacity)
+    : data_{static_cast<core::Byte*>(std::aligned_alloc(kPageSize, (capacity + kPageSize - 1) / kPageSize * kPageSize))},
+      capacity_{data_ ? capacity : 0} {}
+
+bool FileHandler::OutputBuffer::Allocated() const { return data_ != nullptr; }
+
+core::Span<core::Byte> FileHandler::OutputBuffer::Tail() { return {data_.get() + size_, capacity_ - size_}; }
+
+void FileHandler::OutputBuffer::Commit(std::size_t size) { size_ += size; }
+
+core::Span<const core::Byte> FileHandler::OutputBuffer::Data() const { return {data_.get(), size_}; }
+
+bool FileHandler::OutputBuffer::Empty() const { return size_ == 0; }
+
+void FileHandler::OutputBuffer::Clear() { size_ = 0; }
+
+FileHandler::FileHandler(const FileConfig& config, int fd)
+    : config_{config},
+      fd_{fd},
+      active_{config.buffer_size},
+      spare_{config.buffer_size},
+      last_sync_{std::chrono::steady_clock::now()} {
+  if (config_.flush_interval.count() > 0) {
+    flusher_ = std::thread{&FileHandler::RunFlusher, this};
+  }
+}
+
+FileHandler::~FileHandler() {
+  Shutdown();
+  if (config_.sync_interval.count() > 0) {
+    ::fdatasync(fd_);
+  }
+  ::close(fd_);
+}
+
+void FileHandler::Emit(std::shared_ptr<dlt::Message> message) {
+  // encode before taking the lock; the encoding is cached in the message
+  if (config_.format == FileFormat::kText) {
+    message->ToString();
+  } else {
+    message->Serialized();
+  }
+
+  {
+    std::unique_lock lock{mutex_};
+    auto size = Encode(*message, active_.Tail());
+    if (!size && !active_.Empty()) {
+      lock.unlock();
+      Flush();
+      lock.lock();
+      size = Encode(*message, active_.Tail());
+    }
+    if (!size) {
+      // larger than a whole buffer; the buffer was flushed, so write it as is
+      lock.unlock();
+      WriteOversized(*message);
+      return;
+    }
+    active_.Commit(*size);
+  }
+
+  if (message->GetLogLevel() <= config_.flush_level) {
+    Flush();
+  }
+}
+
+void FileHandler::Flush() {
+  std::scoped_lock write_lock{write_mutex_};
+  {
+    std::scoped_lock lock{mutex_};
+    if (active_.Empty()) {
+      return;
+    }
+    std::swap(active_, spare_);
+  }
+
+  BeforeWrite(spare_.Data().size());
+  WriteAll(spare_.Data());
+  spare_.Clear();
+
+  if (config_.sync_interval.count() > 0) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_sync_ >= config_.sync_interval) {
+      ::fdatasync(fd_);
+      last_sync_ = now;
+    }
+  }
+}
+
+std::uint64_t FileHandler::Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+void FileHandler::WriteOversized(const dlt::Message& message) {
+  if (config_.format == FileFormat::kDlt) {
+    const auto bytes = message.Serialized();
+    if (bytes.empty()) {
+      // too large for the 16 bit length field; anything written instead would make readers misparse the records after
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    std::scoped_lock write_lock{write_mutex_};
+    BeforeWrite(bytes.size());
+    WriteAll(bytes);
+    return;
+  }
+
+  std::scoped_lock write_lock{write_mutex_};
+  const auto& text = message.ToString();
+  BeforeWrite(text.size() + 1);
+  WriteAll(std::as_bytes(core::Span<const char>{text.data(), text.size()}));
+  WriteAll(std::as_bytes(core::Span<const char>{"\n", 1}));
+}
+
+int FileHandler::OpenFile(const core::String& path) {
+  return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+}
+
+void FileHandler::BeforeWrite(std::size_t) {}
+
+int FileHandler::ReplaceFile(int fd) { return std::exchange(fd_, fd); }
+
+void FileHandler::Shutdown() {
+  {
+    std::scoped_lock lock{flusher_mutex_};
+    stopping_ = true;
+  }
+  flusher_cv_.notify_one();
+  if (flusher_.joinable()) {
+    flusher_.join();
+  }
+  Flush();
+}
+
+const FileConfig& FileHandler::Config() const { return config_; }
+
+core::Optional<std::size_t> FileHandler::Encode(const dlt::Message& message, core::Span<core::Byte> tail) const {
+  if (config_.format == FileFormat::kDlt) {
+    const auto bytes = message.Serialized();
+    if (bytes.empty() || bytes.size() > tail.size()) {
+      return std::nullopt;
+    }
+    std::memcpy(tail.data(), bytes.data(), bytes.size());
+    return bytes.size();
+  }
+
+  const auto& text = message.ToString();
+  if (text.size() + 1 > tail.size()) {
+    return std::nullopt;
+  }
+  std::memcpy(tail.data(), text.data(), text.size());
+  tail[text.size()] = core::Byte{'\n'};
+  return text.size() + 1;
+}
+
+void FileHandler::WriteAll(core::Span<const core::Byte> data) {
+  while (!data.empty()) {
+    const auto written = ::write(fd_, data.data(), data.size());
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // nowhere to report the error to; drop the data rather than retrying forever
+      return;
+    }
+    data = data.subspan(static_cast<std::size_t>(written));
+  }
+}
+
+void FileHandler::RunFlusher() {
+  std::unique_lock lock{flusher_mutex_};
+  while (!flusher_cv_.wait_for(lock, config_.flush_interval, [this]() { return stopping_; })) {
+    lock.unlock();
+    Flush();
+    lock.lock();
+  }
+}
+}  // namespace ara::log
@@ -0,0 +1,179 @@
+#include "ara/log/flight_recorder.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#include "ara/core/vector.h"
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_error_domain.h"
+#include "ara/log/logging_handler.h"
+
+namespace {
+constexpr std::size_t kPageSize{4096};
+
+/// @brief Memory mapping of a whole file, unmapped on destruction.
+class Mapping {
+ public:
+  Mapping(void* address, std::size_t size) : address_{address}, size_{size} {}
+
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  ~Mapping() {
+    if (address_ != MAP_FAILED) {
+      ::munmap(address_, size_);
+    }
+  }
+
+  const ara::core::Byte* Data() const { return static_cast<const ara::core::Byte*>(address_); }
+
+  bool Valid() const { return address_ != MAP_FAILED; }
+
+ private:
+  void* address_;
+  std::size_t size_;
+};
+}  // namespace
+
+namespace ara::log {
+namespace flight_recorder {
+core::Result<void> Read(core::StringView path, const std::function<void(core::Span<const core::Byte>)>& on_message) {
+  using R = core::Result<void>;
+
+  const auto fd = ::open(core::String{path}.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return R::FromError(LogErrc::kOpenSinkFailed);
+  }
+  struct stat st {};
+  const auto size = ::fstat(fd, &st) == 0 ? static_cast<std::size_t>(st.st_size) : 0;
+  const Mapping mapping{size > kDataOffset ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED, size};
+  ::close(fd);
+  if (!mapping.Valid()) {
+    return R::FromError(LogErrc::kOpenSinkFailed);
+  }
+
+  const auto& header = *reinterpret_cast<const FileHeader*>(mapping.Data());
+  if (header.magic != kFileMagic || header.capacity != size - kDataOffset) {
+    return R::FromError(LogErrc::kOpenSinkFailed);
+  }
+  const auto capacity = static_cast<std::size_t>(header.capacity);
+  const auto* data = mapping.Data() + kDataOffset;
+
+  // every aligned offset may hold a record, including ones inside the payload of records overwritten since
+  struct Record {
+    std::uint64_t position;
+    std::size_t offset;
+    std::size_t size;
+  };
+  core::Vector<Record> records;
+  for (std::size_t offset{0}; offset + sizeof(RecordHeader) <= capacity; offset += kRecordAlignment) {
+    const auto& record = *reinterpret_cast<const RecordHeader*>(data + offset);
+    if (record.magic.load(std::memory_order_acquire) == kRecordMagic && record.position % capacity == offset &&
+        offset + RecordSize(record.size) <= capacity) {
+      records.push_back(Record{record.position, offset, record.size});
+    }
+  }
+
+  // newer records win where records overlap, since an overlapped older record has been partly overwritten
+  std::sort(records.begin(), records.end(), [](const Record& lhs, const Record& rhs) { return lhs.position > rhs.position; });
+  std::map<std::size_t, std::size_t> taken;  // offset -> end of the accepted records
+  core::Vector<Record> recovered;
+  for (const auto& record : records) {
+    const auto end = record.offset + RecordSize(record.size);
+    const auto next = taken.lower_bound(record.offset);
+    const bool overlaps_next = next != taken.end() && next->first < end;
+    const bool overlaps_previous = next != taken.begin() && std::prev(next)->second > record.offset;
+    if (!overlaps_next && !overlaps_previous) {
+      taken.emplace(record.offset, end);
+      recovered.push_back(record);
+    }
+  }
+
+  for (auto it = recovered.rbegin(); it != recovered.rend(); ++it) {
+    on_message({data + it->offset + sizeof(RecordHeader), it->size});
+  }
+  return R::FromValue();
+}
+}  // namespace flight_recorder
+
+core::Result<std::unique_ptr<FlightRecorderHandler>> FlightRecorderHandler::Open(const FlightRecorderConfig& config) {
+  using R = core::Result<std::unique_ptr<FlightRecorderHandler>>;
+  using flight_recorder::FileHeader;
+
+  const auto capacity = (config.size + kPageSize - 1) / kPageSize * kPageSize;
+  const auto mapping_size = flight_recorder::kDataOffset + capacity;
+  const auto fd = ::open(config.path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    return R::FromError(LogErrc::kOpenSinkFailed);
+  }
+  struct stat st {};
+  const bool reuse = ::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) == mapping_size;
+  if (!reuse && ::ftruncate(fd, 0) != 0) {
+    ::close(fd);
+    return R::FromError(LogErrc::kOpenSinkFailed);
+  }
+  // reserve the blocks now, so that stores into the mapping cannot fail for lack of space later
+  if (::posix_fallocate(fd, 0, static_cast<off_t>(mapping_size)) != 0) {
+    ::close(fd);
+    return R::FromError(LogErrc::kOpenSinkFailed);
+  }
+  auto* const mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    return R::FromError(LogErrc::kOpenSinkFailed);
+  }
+
+  auto* const header = static_cast<FileHeader*>(mapping);
+  if (!reuse || header->magic != flight_recorder::kFileMagic || header->capacity != capacity) {
+    std::memset(mapping, 0, mapping_size);
+    header->magic = flight_recorder::kFileMagic;
+    header->capacity = capacity;
+    header->head.store(0, std::memory_order_relaxed);
+  }
+  return R::FromValue(std::make_unique<FlightRecorderHandler>(mapping, mapping_size));
+}
+
+FlightRecorderHandler::FlightRecorderHandler(void* mapping, std::size_t mapping_size)
+    : mapping_{mapping},
+      mapping_size_{mapping_size},
+      header_{static_cast<flight_recorder::FileHeader*>(mapping)},
+      data_{static_cast<core::Byte*>(mapping) + flight_recorder::kDataOffset},
+      capacity_{mapping_size - flight_recorder::kDataOffset} {}
+
+FlightRecorderHandler::~FlightRecorderHandler() { ::munmap(mapping_, mapping_size_); }
+
+void FlightRecorderHandler::Emit(std::shared_ptr<dlt::Message> message) {
+  using flight_recorder::RecordHeader;
+
+  const auto bytes = message->Serialized();
+  const auto message_size = bytes.size();
+  const auto record_size = flight_recorder::RecordSize(message_size);
+  if (message_size == 0 || record_size > capacity_) {
+    return;
+  }
+
+  // records do not wrap; the tail of the ring too short for this one is skipped
+  auto head = header_->head.load(std::memory_order_relaxed);
+  std::uint64_t position;
+  do {
+    const auto offset = static_cast<std::size_t>(head % capacity_);
+    position = offset + record_size > capacity_ ? head + (capacity_ - offset) : head;
+  } while (!header_->head.compare_exchange_weak(head, position + record_size, std::memory_order_relaxed));
+
+  auto* const record_data = data_ + position % capacity_;
+  auto* const record = reinterpret_cast<RecordHeader*>(record_data);
+  // invalidate whatever record was here before overwriting it
+  record->magic.store(0, std::memory_order_relaxed);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  record->size = static_cast<std::uint32_t>(message_size);
+  record->position = position;
+  std::memcpy(record_data + sizeof(RecordHeader), bytes.data(), message_size);
+  record->magic.store(flight_recorder::kRecordMagic, std::memory_order_release);
+}
+}  // namespace ara::log
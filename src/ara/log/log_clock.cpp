@@ -0,0 +1,76 @@
+#include "ara/log/log_clock.h"
+
+#include <thread>
+
+namespace {
+/// @brief Linear map from counter ticks to nanoseconds of MonotonicClock.
+struct TscCalibration {
+  std::uint64_t base_ticks;
+  std::int64_t base_nanoseconds;
+  /// @brief nanoseconds per tick as a 32.32 fixed point number
+  std::uint64_t scale;
+};
+
+constexpr std::uint32_t kScaleShift{32};
+
+TscCalibration Calibrate() {
+  using ara::log::MonotonicClock;
+  using ara::log::TscClock;
+
+  const auto begin_ticks = TscClock::Ticks();
+  const auto begin = MonotonicClock::now();
+#if defined(__aarch64__)
+  std::uint64_t frequency;
+  asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+  const auto scale = (std::uint64_t{1'000'000'000} << kScaleShift) / frequency;
+#else
+  // the counter frequency is not architecturally visible, so measure it against the monotonic clock
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  const auto end_ticks = TscClock::Ticks();
+  const auto end = MonotonicClock::now();
+  const auto elapsed = static_cast<unsigned __int128>((end - begin).count());
+  const auto scale = static_cast<std::uint64_t>((elapsed << kScaleShift) / (end_ticks - begin_ticks));
+#endif
+  return TscCalibration{begin_ticks, begin.time_since_epoch().count(), scale};
+}
+}  // namespace
+
+namespace ara::log {
+TscClock::duration TscClock::ToDuration(std::uint64_t ticks) noexcept {
+  static const TscCalibration kCalibration{Calibrate()};
+  // ticks before the calibration would wrap; they only occur if counters differ between cores, so clamp them
+  const auto elapsed = ticks > kCalibration.base_ticks ? ticks - kCalibration.base_ticks : 0;
+  const auto nanoseconds = (static_cast<unsigned __int128>(elapsed) * kCalibration.scale) >> kScaleShift;
+  return duration{kCalibration.base_nanoseconds + static_cast<rep>(nanoseconds)};
+}
+
+void TimeSource::Init(ClockSource clock_source) {
+  clock_source_ = clock_source;
+  const auto realtime = RealtimeClock::now().time_since_epoch().count();
+  switch (clock_source_) {
+    case ClockSource::kMonotonic:
+    case ClockSource::kMonotonicCoarse:
+      realtime_offset_ = realtime - MonotonicClock::now().time_since_epoch().count();
+      break;
+    case ClockSource::kTsc:
+      // also calibrates the counter, so that the first message does not pay for it
+      realtime_offset_ = realtime - TscClock::now().time_since_epoch().count();
+      break;
+    default:
+      realtime_offset_ = 0;
+      break;
+  }
+}
+
+std::uint64_t TimeSource::ToRealtime(std::uint64_t raw) const noexcept {
+  switch (clock_source_) {
+    case ClockSource::kMonotonic:
+    case ClockSource::kMonotonicCoarse:
+      return raw + static_cast<std::uint64_t>(realtime_offset_);
+    case ClockSource::kTsc:
+      return static_cast<std::uint64_t>(TscClock::ToDuration(raw).count() + realtime_offset_);
+    default:
+      return raw;
+  }
+}
+}  // namespace ara::log
@@ -1,10 +1,95 @@
 #include "ara/log/log_config.h"
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 
+#include "ara/core/optional.h"
 #include "ara/log/log_error_domain.h"
 #include "nlohmann/json.hpp"
 
+namespace {
+ara::core::Optional<ara::log::OverflowPolicy> ParseOverflowPolicy(ara::core::StringView policy) {
+  if (policy == "DROP_NEWEST") {
+    return ara::log::OverflowPolicy::kDropNewest;
+  }
+  if (policy == "DROP_OLDEST") {
+    return ara::log::OverflowPolicy::kDropOldest;
+  }
+  if (policy == "BLOCK") {
+    return ara::log::OverflowPolicy::kBlock;
+  }
+  return std::nullopt;
+}
+
+ara::core::Optional<ara::log::ClockSource> ParseClockSource(ara::core::StringView clock_source) {
+  if (clock_source == "REALTIME") {
+    return ara::log::ClockSource::kRealtime;
+  }
+  if (clock_source == "REALTIME_COARSE") {
+    return ara::log::ClockSource::kRealtimeCoarse;
+  }
+  if (clock_source == "MONOTONIC") {
+    return ara::log::ClockSource::kMonotonic;
+  }
+  if (clock_source == "MONOTONIC_COARSE") {
+    return ara::log::ClockSource::kMonotonicCoarse;
+  }
+  if (clock_source == "TSC") {
+    return ara::log::ClockSource::kTsc;
+  }
+  return std::nullopt;
+}
+
+ara::core::Optional<ara::log::FileFormat> ParseFileFormat(ara::core::StringView format) {
+  if (format == "TEXT") {
+    return ara::log::FileFormat::kText;
+  }
+  if (format == "DLT") {
+    return ara::log::FileFormat::kDlt;
+  }
+  return std::nullopt;
+}
+
+ara::core::Optional<ara::log::NetworkProtocol> ParseNetworkProtocol(ara::core::StringView protocol) {
+  if (protocol == "TCP") {
+    return ara::log::NetworkProtocol::kTcp;
+  }
+  if (protocol == "UDP") {
+    return ara::log::NetworkProtocol::kUdp;
+  }
+  return std::nullopt;
+}
+
+ara::core::Optional<ara::log::LogLevel> ParseLogLevel(ara::core::StringView log_level) {
+  constexpr std::array<ara::core::StringView, 7> kNames{"OFF", "FATAL", "ERROR", "WARN", "INFO", "DEBUG", "VERBOSE"};
+  for (std::size_t i{0}; i < kNames.size(); ++i) {
+    if (log_level == kNames[i]) {
+      return static_cast<ara::log::LogLevel>(i);
+    }
+  }
+  return std::nullopt;
+}
+
+/// @brief Return the positions in log_sinks of the sinks named, or of all sinks if none are; a name may stand for
+/// several sinks of the same type.
+ara::core::Optional<ara::log::SinkMask> ParseSinks(const ara::core::Vector<ara::core::String>& names,
+                                                   const ara::core::Vector<ara::core::String>& log_sinks) {
+  ara::log::SinkMask sinks{0};
+  for (std::size_t i{0}; i < log_sinks.size(); ++i) {
+    if (names.empty() || std::find(names.begin(), names.end(), log_sinks[i]) != names.end()) {
+      sinks |= ara::log::SinkMask{1} << i;
+    }
+  }
+  for (const auto& name : names) {
+    if (std::find(log_sinks.begin(), log_sinks.end(), name) == log_sinks.end()) {
+      return std::nullopt;
+    }
+  }
+  return sinks;
+}
+}  // namespace
+
 namespace ara::log {
 
 core::Result<void> LogConfig::Init(core::StringView config_path) {
@@ -17,6 +102,118 @@ core::Result<void> LogConfig::Init(core::StringView config_path) {
     ecu_id_ = config["EcuId"].get<core::String>();
     log_sinks_ = config["LogSinks"].get<core::Vector<core::String>>();
     app_id_ = config["AppId"].get<core::String>();
+    if (log_sinks_.size() > kMaxSinks) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+
+    if (config.contains("Async")) {
+      const auto& async = config["Async"];
+      async_.enabled = async.value("Enabled", async_.enabled);
+      async_.queue_capacity = async.value("QueueCapacity", async_.queue_capacity);
+      const auto policy = ParseOverflowPolicy(async.value("OverflowPolicy", core::String{"DROP_NEWEST"}));
+      if (!policy || async_.queue_capacity == 0) {
+        return R::FromError(LogErrc::kInvalidConfig);
+      }
+      async_.overflow_policy = *policy;
+    }
+
+    const auto clock_source = ParseClockSource(config.value("ClockSource", core::String{"REALTIME"}));
+    if (!clock_source) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+    clock_source_ = *clock_source;
+
+    const auto& file_config = config.contains("File") ? config["File"] : nlohmann::json::object();
+    const auto file_format = ParseFileFormat(file_config.value("Format", core::String{"TEXT"}));
+    const auto flush_level = ParseLogLevel(file_config.value("FlushLevel", core::String{"ERROR"}));
+    if (!file_format || !flush_level) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+    file_.format = *file_format;
+    file_.flush_level = *flush_level;
+    file_.path = file_config.value("Path", app_id_ + (file_.format == FileFormat::kDlt ? ".dlt" : ".log"));
+    // a buffer must at least hold the largest DLT message
+    file_.buffer_size = std::max<std::size_t>(file_config.value("BufferSize", file_.buffer_size), 1 << 16);
+    file_.flush_interval = std::chrono::milliseconds{file_config.value("FlushIntervalMs", file_.flush_interval.count())};
+    file_.sync_interval = std::chrono::milliseconds{file_config.value("SyncIntervalMs", file_.sync_interval.count())};
+
+    const auto& rotation = file_config.contains("Rotation") ? file_config["Rotation"] : nlohmann::json::object();
+    file_.rotation.max_bytes = rotation.value("MaxBytes", file_.rotation.max_bytes);
+    file_.rotation.interval = std::chrono::seconds{rotation.value("IntervalS", file_.rotation.interval.count())};
+    file_.rotation.backup_count = rotation.value("BackupCount", file_.rotation.backup_count);
+    file_.rotation.compress = rotation.value("Compress", file_.rotation.compress);
+    if (file_.rotation.max_bytes == 0 || file_.rotation.interval.count() <= 0) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+
+    const auto& flight_recorder =
+        config.contains("FlightRecorder") ? config["FlightRecorder"] : nlohmann::json::object();
+    flight_recorder_.path = flight_recorder.value("Path", app_id_ + ".fdr");
+    // the ring must at least hold the largest DLT message
+    flight_recorder_.size = std::max<std::size_t>(flight_recorder.value("SizeBytes", flight_recorder_.size), 1 << 17);
+
+    const auto& network = config.contains("Network") ? config["Network"] : nlohmann::json::object();
+    const auto protocol = ParseNetworkProtocol(network.value("Protocol", core::String{"TCP"}));
+    if (!protocol) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+    network_.protocol = *protocol;
+    network_.host = network.value("Host", network_.host);
+    network_.port = network.value("Port", network_.port);
+    // a buffer must at least hold the largest DLT message
+    network_.buffer_size = std::max<std::size_t>(network.value("BufferSize", network_.buffer_size), 1 << 16);
+    network_.datagram_size = network.value("DatagramSize", network_.datagram_size);
+    network_.flush_interval =
+        std::chrono::milliseconds{network.value("FlushIntervalMs", network_.flush_interval.count())};
+    network_.reconnect_interval =
+        std::chrono::milliseconds{network.value("ReconnectIntervalMs", network_.reconnect_interval.count())};
+    if (network_.flush_interval.count() <= 0 || network_.reconnect_interval.count() <= 0) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+
+    const auto& control = config.contains("Control") ? config["Control"] : nlohmann::json::object();
+    control_.enabled = control.value("Enabled", control_.enabled);
+    control_.path = control.value("Path", app_id_ + ".ctl");
+
+    routes_.clear();
+    for (const auto& route : config.contains("Routes") ? config["Routes"] : nlohmann::json::array()) {
+      const auto log_level = ParseLogLevel(route.value("Level", core::String{"VERBOSE"}));
+      const auto sinks = ParseSinks(route.value("Sinks", core::Vector<core::String>{}), log_sinks_);
+      if (!log_level || !sinks) {
+        return R::FromError(LogErrc::kInvalidConfig);
+      }
+      routes_.push_back(RouteConfig{route.value("Context", core::String{}), *log_level, *sinks});
+    }
+
+    const auto& rate_limit = config.contains("RateLimit") ? config["RateLimit"] : nlohmann::json::object();
+    rate_limit_.summary_interval =
+        std::chrono::milliseconds{rate_limit.value("SummaryIntervalMs", rate_limit_.summary_interval.count())};
+    if (rate_limit_.summary_interval.count() < 0) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+
+    const auto& coalesce = config.contains("Coalesce") ? config["Coalesce"] : nlohmann::json::object();
+    coalesce_.enabled = coalesce.value("Enabled", coalesce_.enabled);
+    coalesce_.window = std::chrono::milliseconds{coalesce.value("WindowMs", coalesce_.window.count())};
+    coalesce_.capacity = coalesce.value("Capacity", coalesce_.capacity);
+    // the coalescer runs on the writer thread; logging threads sharing it would serialize on one lock
+    if (coalesce_.window.count() <= 0 || coalesce_.capacity == 0 || (coalesce_.enabled && !async_.enabled)) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+
+    const auto& backtrace = config.contains("Backtrace") ? config["Backtrace"] : nlohmann::json::object();
+    const auto backtrace_level = ParseLogLevel(backtrace.value("Level", core::String{"OFF"}));
+    if (!backtrace_level) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+    backtrace_.level = *backtrace_level;
+    backtrace_.contexts = backtrace.value("Contexts", core::Vector<core::String>{});
+    // read signed, so that a negative depth is rejected rather than wrapped
+    const auto backtrace_depth = backtrace.value("Depth", static_cast<std::int64_t>(backtrace_.depth));
+    if (backtrace_depth < 0 || static_cast<std::uint64_t>(backtrace_depth) > kMaxBacktraceDepth) {
+      return R::FromError(LogErrc::kInvalidConfig);
+    }
+    backtrace_.depth = static_cast<std::size_t>(backtrace_depth);
     return R::FromValue();
   } catch (...) {
     return R::FromError(LogErrc::kInvalidConfig);
@@ -28,4 +225,24 @@ const core::String& LogConfig::EcuId() const { return ecu_id_; }
 const core::Vector<core::String>& LogConfig::LogSinks() const { return log_sinks_; }
 
 const core::String& LogConfig::AppId() const { return app_id_; }
+
+const AsyncConfig& LogConfig::Async() const { return async_; }
+
+ClockSource LogConfig::GetClockSource() const { return clock_source_; }
+
+const FileConfig& LogConfig::File() const { return file_; }
+
+const FlightRecorderConfig& LogConfig::FlightRecorder() const { return flight_recorder_; }
+
+const NetworkConfig& LogConfig::Network() const { return network_; }
+
+const ControlConfig& LogConfig::Control() const { return control_; }
+
+const core::Vector<RouteConfig>& LogConfig::Routes() const { return routes_; }
+
+const RateLimitConfig& LogConfig::RateLimit() const { return rate_limit_; }
+
+const CoalesceConfig& LogConfig::Coalesce() const { return coalesce_; }
+
+const BacktraceConfig& LogConfig::Backtrace() const { return backtrace_; }
 }  // namespace ara::log
@@ -11,6 +11,12 @@ const char* LogErrorDomain::Message(CodeType error_code) const noexcept {
       return "invalid log config";
     case Errc::kInvalidLogSink:
       return "invalid log sink";
+    case Errc::kOpenSinkFailed:
+      return "failed to open log sink";
+    case Errc::kInvalidControlMessage:
+      return "invalid control message";
+    case Errc::kOpenControlChannelFailed:
+      return "failed to open control channel";
     default:
       return "Unknown error";
   }
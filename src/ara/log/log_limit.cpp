@@ -0,0 +1,35 @@
+#include "ara/log/log_limit.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "ara/log/logger_manager.h"
+
+namespace ara::log {
+bool LogLimit::TakeToken() noexcept {
+  const auto now = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+  auto refill_time = state_.load(std::memory_order_relaxed);
+  std::uint64_t next{0};
+  do {
+    // a full bucket refills from now on; one that would run further ahead than the burst allows has no token
+    const auto start = std::max(refill_time, now);
+    if (start > now + tolerance_) {
+      return false;
+    }
+    next = start + interval_;
+  } while (!state_.compare_exchange_weak(refill_time, next, std::memory_order_relaxed));
+  return true;
+}
+
+void LogLimit::Register(ContextHandle handle, LogLevel log_level) noexcept {
+  if (registered_.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+  // published to the reporter thread by the lock taken in Add()
+  handle_ = handle;
+  log_level_ = log_level;
+  LoggerManager::Instance().GetSuppressionReporter().Add(*this);
+}
+}  // namespace ara::log
@@ -1,13 +1,14 @@
 #include "ara/log/log_stream.h"
 
 #include <cstdint>
+#include <utility>
 
+#include "ara/core/array.h"
 #include "ara/core/utility.h"
 #include "ara/log/dlt_message.h"
 #include "ara/log/logger.h"
-#include "ara/log/logger_manager.h"
+#include "ara/log/object_pool.h"
 #include "fmt/format.h"
-#include "fmt/ranges.h"
 
 namespace {
 ara::core::StringView LogLevel2String(ara::log::LogLevel log_level) {
@@ -35,30 +36,50 @@ ara::core::StringView LogLevel2String(ara::log::LogLevel log_level) {
 namespace ara::log {
 struct LogStream::Impl {
   LogLevel log_level;
-  Logger::Key owner_key;
+  /// @brief copy of the owning Logger, sharing its state, so the stream never has to look it up again.
+  Logger owner;
   std::shared_ptr<dlt::Message> dlt_message{nullptr};
+  /// @brief whether Flush() was called, after which the destructor only emits a message with arguments.
+  bool flushed{false};
 };
 
-LogStream::LogStream(LogLevel log_level, const Logger& logger) : impl_{std::make_shared<Impl>()} {
+/// A stream whose level is filtered by the logger stays inert: impl_ is left empty, so neither the stream state nor
+/// the DLT message (timestamp, config lookups) is ever created for it.
+LogStream::LogStream(LogLevel log_level, const Logger& logger) {
+  if (!logger.IsEnabled(log_level)) {
+    return;
+  }
+
+  auto& pool = ObjectPool<Impl>::Local();
+  if (impl_ = pool.Acquire(); impl_) {
+    *impl_ = Impl{log_level, logger};
+  } else {
+    impl_ = std::make_shared<Impl>(Impl{log_level, logger});
+    pool.Adopt(impl_);
+  }
   impl_->dlt_message = dlt::Message::VerboseModeLogMessage(log_level, logger.CtxId());
-  impl_->log_level = log_level;
-  impl_->owner_key = logger.GetKey();
 }
 
 LogStream::~LogStream() noexcept {
-  if (impl_->dlt_message) {
-    Flush();
+  if (Enabled() && impl_->dlt_message) {
+    if (!impl_->flushed || impl_->dlt_message->GetPayload().NumberOfArguments() > 0) {
+      impl_->owner.Handle(std::move(impl_->dlt_message));
+    }
+    // the pooled Impl must not keep the message from returning to its own pool
+    impl_->dlt_message.reset();
   }
 }
 
+/// The emitted message belongs to the sinks from here on (in async mode to the writer thread), so the stream continues
+/// in a message of its own rather than appending to one that is being rendered.
 void LogStream::Flush() noexcept {
-  const auto logger_opt = LoggerManager::Instance().GetLogger(impl_->owner_key);
-  if (!logger_opt) {
-    fmt::print("logger[{}] doesn't exist.", impl_->owner_key);
+  if (!Enabled()) {
     return;
   }
 
-  logger_opt->get().Handle(impl_->dlt_message);
+  impl_->owner.Handle(std::exchange(impl_->dlt_message,
+                                    dlt::Message::VerboseModeLogMessage(impl_->log_level, impl_->owner.CtxId())));
+  impl_->flushed = true;
 }
 
 LogStream& LogStream::operator<<(bool value) noexcept {
@@ -140,40 +161,71 @@ LogStream& LogStream::operator<<(double value) noexcept {
 
 LogStream& LogStream::operator<<(const core::StringView value) noexcept {
   if (Enabled()) {
-    impl_->dlt_message->AddArgument(value.data());
+    impl_->dlt_message->AddArgument(value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const char* const value) noexcept {
   if (Enabled()) {
-    impl_->dlt_message->AddArgument(value);
+    impl_->dlt_message->AddArgument(core::StringView{value});
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(core::Span<const core::Byte> value) noexcept {
   if (Enabled()) {
-    impl_->dlt_message->AddArgument(fmt::format("{}", fmt::join(value, "")).data());
+    impl_->dlt_message->AddArgument(value);
+  }
+  return *this;
+}
+
+LogStream& LogStream::WithLocation(core::StringView file, int line) noexcept {
+  if (Enabled()) {
+    impl_->dlt_message->SetSourceLocation(file, static_cast<std::uint32_t>(line));
   }
   return *this;
 }
 
-LogStream& LogStream::WithLocation(core::StringView file, int line) noexcept { return *this; }
+LogStream& LogStream::WithTag(core::StringView tag) noexcept {
+  if (Enabled()) {
+    impl_->dlt_message->AddTag(tag);
+  }
+  return *this;
+}
 
-LogStream& LogStream::WithTag(core::StringView tag) noexcept { return *this; }
+bool LogStream::Enabled() const { return impl_ != nullptr; }
 
-bool LogStream::Enabled() const {
-  const auto loggerOpt = LoggerManager::Instance().GetLogger(impl_->owner_key);
-  if (!loggerOpt) {
-    return false;
+template <typename T>
+LogStream& LogStream::AddArgument(T value, const ArgumentAttributes& attributes) noexcept {
+  if (Enabled()) {
+    impl_->dlt_message->AddArgument(value, attributes);
   }
-  return loggerOpt->get().IsEnabled(impl_->log_level);
+  return *this;
 }
 
+template LogStream& LogStream::AddArgument(bool, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(std::uint8_t, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(std::uint16_t, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(std::uint32_t, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(std::uint64_t, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(std::int8_t, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(std::int16_t, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(std::int32_t, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(std::int64_t, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(float, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(double, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(core::StringView, const ArgumentAttributes&) noexcept;
+template LogStream& LogStream::AddArgument(core::Span<const core::Byte>, const ArgumentAttributes&) noexcept;
+
 LogStream& operator<<(LogStream& out, LogLevel value) noexcept { return out << LogLevel2String(value); }
 
 LogStream& operator<<(LogStream& out, const core::InstanceSpecifier& value) noexcept { return out << value.ToString(); }
 
-LogStream& operator<<(LogStream& out, const void* value) noexcept { return out << fmt::format("{}", value); }
+LogStream& operator<<(LogStream& out, const void* value) noexcept {
+  // formatted on the stack, so that a filtered stream does not pay for a heap allocation
+  core::Array<char, 2 + 2 * sizeof value + 1> text{};
+  const auto result = fmt::format_to_n(text.data(), text.size() - 1, "{}", value);
+  return out << core::StringView{text.data(), result.size};
+}
 }  // namespace ara::log
\ No newline at end of file
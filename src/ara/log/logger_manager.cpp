@@ -1,7 +1,11 @@
 #include "ara/log/logger_manager.h"
 
+#include <bit>
+
 #include "ara/core/result.h"
 #include "ara/log/common.h"
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_clock.h"
 #include "ara/log/log_config.h"
 #include "ara/log/log_error_domain.h"
 #include "ara/log/logging_handler.h"
@@ -9,33 +13,123 @@
 namespace ara::log {
 core::Result<void> LoggerManager::Init() {
   using R = core::Result<void>;
+  TimeSource::Instance().Init(LogConfig::Instance().GetClockSource());
+
   const auto log_sinks = LogConfig::Instance().LogSinks();
   for (const auto& log_sink : log_sinks) {
     if (log_sink == "CONSOLE") {
       logging_handlers_.emplace_back(std::make_unique<ConsoleHandler>());
+    } else if (log_sink == "FILE" || log_sink == "ROTATING_FILE" || log_sink == "TIMED_ROTATING_FILE") {
+      const auto& file_config = LogConfig::Instance().File();
+      auto file_handler = log_sink == "FILE"            ? FileHandler::Open(file_config)
+                          : log_sink == "ROTATING_FILE" ? FileHandler::Open<RotatingFileHandler>(file_config)
+                                                        : FileHandler::Open<TimedRotatingFileHandler>(file_config);
+      if (!file_handler) {
+        return R::FromError(file_handler.Error());
+      }
+      logging_handlers_.emplace_back(std::move(file_handler).Value());
+    } else if (log_sink == "FLIGHT_RECORDER") {
+      auto flight_recorder = FlightRecorderHandler::Open(LogConfig::Instance().FlightRecorder());
+      if (!flight_recorder) {
+        return R::FromError(flight_recorder.Error());
+      }
+      logging_handlers_.emplace_back(std::move(flight_recorder).Value());
+    } else if (log_sink == "NETWORK") {
+      auto network_handler = NetworkHandler::Open(LogConfig::Instance().Network());
+      if (!network_handler) {
+        return R::FromError(network_handler.Error());
+      }
+      network_handler_ = network_handler.Value().get();
+      logging_handlers_.emplace_back(std::move(network_handler).Value());
     } else {
       return R::FromError(LogErrc::kInvalidLogSink);
     }
   }
 
+  contexts_.SetRoutes(LogConfig::Instance().Routes(), logging_handlers_.size());
+  contexts_.SetBacktrace(LogConfig::Instance().Backtrace());
+
+  if (const auto& coalesce_config = LogConfig::Instance().Coalesce(); coalesce_config.enabled) {
+    coalescer_ = std::make_unique<Coalescer>(coalesce_config, logging_handlers_);
+  }
+
+  if (const auto& async_config = LogConfig::Instance().Async(); async_config.enabled) {
+    async_dispatcher_ = std::make_unique<AsyncDispatcher>(async_config, logging_handlers_, coalescer_.get());
+  }
+
+  if (const auto interval = LogConfig::Instance().RateLimit().summary_interval; interval.count() > 0) {
+    suppression_reporter_.Start(interval);
+  }
+
+  if (const auto& control_config = LogConfig::Instance().Control(); control_config.enabled) {
+    auto control_server = ControlServer::Open(control_config, contexts_);
+    if (!control_server) {
+      return R::FromError(control_server.Error());
+    }
+    control_server_ = std::move(control_server).Value();
+  }
+
   return R::FromValue();
 }
 
+void LoggerManager::Deinit() {
+  suppression_reporter_.Stop();
+  if (async_dispatcher_) {
+    async_dispatcher_->Stop();
+  }
+  // the writer thread has stopped, and later messages bypass the coalescer
+  if (coalescer_) {
+    coalescer_->Flush();
+  }
+  control_server_.reset();
+}
+
 Logger& LoggerManager::CreateLogger(core::StringView ctx_id, core::StringView ctx_desc, LogLevel threshold) {
-  const auto logger = new Logger(ctx_id, ctx_desc, threshold);
-  auto& key = logger->GetKey();
-  std::scoped_lock lock{loggers_mtx_};
-  return *loggers_.emplace(key, std::unique_ptr<Logger>(logger)).first->second;
+  return contexts_.GetOrCreate(ctx_id, ctx_desc, threshold);
 }
 
 core::Optional<std::reference_wrapper<Logger>> LoggerManager::GetLogger(const Logger::Key& key) {
-  std::scoped_lock lock{loggers_mtx_};
-  if (const auto it = loggers_.find(key); it == loggers_.end()) {
-    return std::nullopt;
-  } else {
-    return {*it->second};
+  if (auto* const logger = contexts_.Find(key)) {
+    return {*logger};
   }
+  return std::nullopt;
+}
+
+core::Optional<std::reference_wrapper<Logger>> LoggerManager::GetLogger(ContextHandle handle) {
+  if (auto* const logger = contexts_.Find(handle)) {
+    return {*logger};
+  }
+  return std::nullopt;
 }
 
 const core::Vector<std::unique_ptr<LoggingHandler>>& LoggerManager::GetLoggingHandlers() { return logging_handlers_; }
+
+SuppressionReporter& LoggerManager::GetSuppressionReporter() { return suppression_reporter_; }
+
+ContextRegistry& LoggerManager::GetContexts() { return contexts_; }
+
+void LoggerManager::Handle(std::shared_ptr<dlt::Message> message) {
+  if (message->Sinks() == 0) {
+    return;
+  }
+  if (async_dispatcher_) {
+    async_dispatcher_->Push(std::move(message));
+    return;
+  }
+  // the positions of the handlers are those of their sinks in the routing masks
+  for (auto sinks = message->Sinks(); sinks != 0; sinks &= sinks - 1) {
+    logging_handlers_[std::countr_zero(sinks)]->Emit(message);
+  }
+}
+
+ClientState LoggerManager::RemoteClientState() const {
+  return network_handler_ ? network_handler_->GetClientState() : ClientState::kUnknown;
+}
+
+core::Optional<AsyncDispatcher::Statistics> LoggerManager::GetAsyncStatistics() const {
+  if (!async_dispatcher_) {
+    return std::nullopt;
+  }
+  return async_dispatcher_->GetStatistics();
+}
 }  // namespace ara::log
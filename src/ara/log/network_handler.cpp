@@ -0,0 +1,410 @@
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_error_domain.h"
+#include "ara/log/logging_handler.h"
+#include "asio.hpp"
+
+namespace {
+/// @brief number of datagrams passed to one sendmmsg call
+constexpr std::size_t kDatagramBatch{64};
+/// @brief how long the destructor waits for the buffered messages to be sent
+constexpr std::chrono::seconds kShutdownTimeout{1};
+
+/// @brief Serialized messages waiting to be sent.
+struct Batch {
+  explicit Batch(std::size_t capacity) : data(capacity) {}
+
+  bool Empty() const { return size == 0; }
+
+  void Clear() {
+    size = 0;
+    datagram_ends.clear();
+  }
+
+  ara::core::Vector<ara::core::Byte> data;
+  std::size_t size{0};
+  /// @brief UDP only: end offsets of the datagrams before the last one
+  ara::core::Vector<std::size_t> datagram_ends;
+};
+}  // namespace
+
+namespace ara::log {
+struct NetworkHandler::Impl {
+  explicit Impl(const NetworkConfig& network_config)
+      : config{network_config},
+        work{asio::make_work_guard(io)},
+        tcp_socket{io},
+        udp_socket{io},
+        flush_timer{io},
+        reconnect_timer{io},
+        shutdown_timer{io},
+        active{config.buffer_size},
+        spare{config.buffer_size} {}
+
+  bool Resolve();
+  void Run();
+  void Stop();
+
+  void Connect();
+  void ScheduleReconnect();
+  void Disconnect();
+  void Close();
+  void StartFlushTimer();
+  void StartReceive();
+
+  /// @brief Send the active buffer, unless a send is in progress or the receiver is not connected.
+  void Send();
+  void SendDatagrams();
+  void OnSent(const asio::error_code& error);
+  /// @brief Send what is left once stopping, then close.
+  void Finish();
+
+  const NetworkConfig config;
+  asio::io_context io;
+  asio::executor_work_guard<asio::io_context::executor_type> work;
+  asio::ip::tcp::resolver::results_type tcp_endpoints;
+  asio::ip::udp::endpoint udp_endpoint;
+  asio::ip::tcp::socket tcp_socket;
+  asio::ip::udp::socket udp_socket;
+  asio::steady_timer flush_timer;
+  asio::steady_timer reconnect_timer;
+  asio::steady_timer shutdown_timer;
+  /// @brief discards whatever the receiver sends; a pending receive notices a lost receiver while idle
+  std::array<char, 256> receive_buffer;
+  std::thread thread;
+
+  /// @brief guards active
+  std::mutex mutex;
+  Batch active;
+  std::atomic<ClientState> state{ClientState::kUnknown};
+  std::atomic<std::uint64_t> dropped{0};
+  std::atomic<bool> send_requested{false};
+
+  // only used on the network thread
+  Batch spare;
+  std::size_t next_datagram{0};
+  bool connected{false};
+  bool sending{false};
+  bool stopping{false};
+};
+
+bool NetworkHandler::Impl::Resolve() {
+  const auto port = std::to_string(config.port);
+  asio::error_code error;
+  if (config.protocol == NetworkProtocol::kTcp) {
+    tcp_endpoints = asio::ip::tcp::resolver{io}.resolve(config.host, port, error);
+    return !error && !tcp_endpoints.empty();
+  }
+
+  const auto endpoints = asio::ip::udp::resolver{io}.resolve(config.host, port, error);
+  if (error || endpoints.empty()) {
+    return false;
+  }
+  udp_endpoint = *endpoints.begin();
+  return true;
+}
+
+void NetworkHandler::Impl::Run() {
+  thread = std::thread{[this]() { io.run(); }};
+  pthread_setname_np(thread.native_handle(), "ara_log_network");
+  asio::post(io, [this]() {
+    Connect();
+    StartFlushTimer();
+  });
+}
+
+void NetworkHandler::Impl::Stop() {
+  if (!thread.joinable()) {
+    return;
+  }
+
+  asio::post(io, [this]() {
+    stopping = true;
+    flush_timer.cancel();
+    reconnect_timer.cancel();
+    // a receiver that stopped reading must not hold up the shutdown
+    shutdown_timer.expires_after(kShutdownTimeout);
+    shutdown_timer.async_wait([this](const asio::error_code& error) {
+      if (!error) {
+        Close();
+      }
+    });
+    Finish();
+  });
+  work.reset();
+  thread.join();
+}
+
+void NetworkHandler::Impl::Connect() {
+  if (stopping) {
+    return;
+  }
+
+  if (config.protocol == NetworkProtocol::kUdp) {
+    // connecting a UDP socket sends nothing, but makes the kernel report unreachable receivers on later sends
+    asio::error_code error;
+    udp_socket.open(udp_endpoint.protocol(), error);
+    if (!error) {
+      udp_socket.non_blocking(true, error);
+    }
+    if (!error) {
+      udp_socket.connect(udp_endpoint, error);
+    }
+    if (error) {
+      udp_socket.close(error);
+      state.store(ClientState::kNotConnected, std::memory_order_relaxed);
+      ScheduleReconnect();
+      return;
+    }
+    // the state only changes once datagrams are sent, as nothing is known about the receiver before
+    connected = true;
+    StartReceive();
+    Send();
+    return;
+  }
+
+  asio::async_connect(tcp_socket, tcp_endpoints,
+                      [this](const asio::error_code& error, const asio::ip::tcp::endpoint&) {
+                        if (stopping) {
+                          return;
+                        }
+                        if (error) {
+                          state.store(ClientState::kNotConnected, std::memory_order_relaxed);
+                          ScheduleReconnect();
+                          return;
+                        }
+                        asio::error_code option_error;
+                        // messages are batched here already, so waiting for more data in the kernel only adds latency
+                        tcp_socket.set_option(asio::ip::tcp::no_delay{true}, option_error);
+                        connected = true;
+                        state.store(ClientState::kConnected, std::memory_order_relaxed);
+                        StartReceive();
+                        Send();
+                      });
+}
+
+void NetworkHandler::Impl::ScheduleReconnect() {
+  if (stopping) {
+    return;
+  }
+  reconnect_timer.expires_after(config.reconnect_interval);
+  reconnect_timer.async_wait([this](const asio::error_code& error) {
+    if (!error) {
+      Connect();
+    }
+  });
+}
+
+void NetworkHandler::Impl::Disconnect() {
+  if (!connected) {
+    return;
+  }
+  connected = false;
+  state.store(ClientState::kNotConnected, std::memory_order_relaxed);
+  asio::error_code error;
+  tcp_socket.close(error);
+  udp_socket.close(error);
+  ScheduleReconnect();
+}
+
+void NetworkHandler::Impl::Close() {
+  connected = false;
+  asio::error_code error;
+  shutdown_timer.cancel();
+  tcp_socket.close(error);
+  udp_socket.close(error);
+}
+
+void NetworkHandler::Impl::StartFlushTimer() {
+  flush_timer.expires_after(config.flush_interval);
+  flush_timer.async_wait([this](const asio::error_code& error) {
+    // the wait may have completed just before the cancel when stopping
+    if (error || stopping) {
+      return;
+    }
+    Send();
+    StartFlushTimer();
+  });
+}
+
+void NetworkHandler::Impl::StartReceive() {
+  auto on_received = [this](const asio::error_code& error, std::size_t) {
+    if (error == asio::error::operation_aborted) {
+      return;
+    }
+    if (error) {
+      Disconnect();
+      return;
+    }
+    StartReceive();
+  };
+  if (config.protocol == NetworkProtocol::kTcp) {
+    tcp_socket.async_read_some(asio::buffer(receive_buffer), on_received);
+  } else {
+    // the kernel reports an unreachable receiver (ICMP port unreachable) as an error on the next receive or send
+    udp_socket.async_receive(asio::buffer(receive_buffer), on_received);
+  }
+}
+
+void NetworkHandler::Impl::Send() {
+  if (sending || !connected) {
+    return;
+  }
+  {
+    std::scoped_lock lock{mutex};
+    if (active.Empty()) {
+      return;
+    }
+    std::swap(active, spare);
+  }
+
+  sending = true;
+  if (config.protocol == NetworkProtocol::kTcp) {
+    asio::async_write(tcp_socket, asio::buffer(spare.data.data(), spare.size),
+                      [this](const asio::error_code& error, std::size_t) { OnSent(error); });
+    return;
+  }
+  spare.datagram_ends.push_back(spare.size);
+  next_datagram = 0;
+  SendDatagrams();
+}
+
+void NetworkHandler::Impl::SendDatagrams() {
+  std::array<mmsghdr, kDatagramBatch> headers{};
+  std::array<iovec, kDatagramBatch> vectors{};
+  const auto& ends = spare.datagram_ends;
+  while (next_datagram < ends.size()) {
+    const auto count = std::min(kDatagramBatch, ends.size() - next_datagram);
+    for (std::size_t i{0}; i < count; ++i) {
+      const auto index = next_datagram + i;
+      const auto begin = index == 0 ? 0 : ends[index - 1];
+      vectors[i] = iovec{spare.data.data() + begin, ends[index] - begin};
+      headers[i] = mmsghdr{};
+      headers[i].msg_hdr.msg_iov = &vectors[i];
+      headers[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const auto sent = ::sendmmsg(udp_socket.native_handle(), headers.data(), static_cast<unsigned int>(count), 0);
+    if (sent >= 0) {
+      next_datagram += static_cast<std::size_t>(sent);
+      continue;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      udp_socket.async_wait(asio::ip::udp::socket::wait_write, [this](const asio::error_code& error) {
+        if (error) {
+          OnSent(error);
+        } else {
+          SendDatagrams();
+        }
+      });
+      return;
+    }
+    if (errno == EMSGSIZE) {
+      // a single message larger than the largest datagram the path allows; nothing to do but skip it
+      ++next_datagram;
+      continue;
+    }
+    OnSent(asio::error_code{errno, asio::error::get_system_category()});
+    return;
+  }
+  OnSent({});
+}
+
+void NetworkHandler::Impl::OnSent(const asio::error_code& error) {
+  // on error the rest of the batch is lost; a new TCP connection starts at a message boundary again
+  spare.Clear();
+  sending = false;
+  if (error) {
+    Disconnect();
+    if (stopping) {
+      Close();
+    }
+    return;
+  }
+  if (config.protocol == NetworkProtocol::kUdp) {
+    state.store(ClientState::kConnected, std::memory_order_relaxed);
+  }
+  if (stopping) {
+    Finish();
+    return;
+  }
+  // whatever arrived during the send goes out right away, so batches grow with the load
+  Send();
+}
+
+void NetworkHandler::Impl::Finish() {
+  if (sending) {
+    return;
+  }
+  Send();
+  if (!sending) {
+    Close();
+  }
+}
+
+core::Result<std::unique_ptr<NetworkHandler>> NetworkHandler::Open(const NetworkConfig& config) {
+  using R = core::Result<std::unique_ptr<NetworkHandler>>;
+  auto handler = std::make_unique<NetworkHandler>(config);
+  if (!handler->impl_->Resolve()) {
+    return R::FromError(LogErrc::kOpenSinkFailed);
+  }
+  handler->impl_->Run();
+  return R::FromValue(std::move(handler));
+}
+
+NetworkHandler::NetworkHandler(const NetworkConfig& config) : impl_{std::make_unique<Impl>(config)} {}
+
+NetworkHandler::~NetworkHandler() { impl_->Stop(); }
+
+void NetworkHandler::Emit(std::shared_ptr<dlt::Message> message) {
+  // serialize before taking the lock; the bytes are cached in the message
+  const auto bytes = message->Serialized();
+  const auto message_size = bytes.size();
+  if (message_size == 0) {
+    impl_->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  bool half_full;
+  {
+    std::scoped_lock lock{impl_->mutex};
+    auto& batch = impl_->active;
+    if (message_size > batch.data.size() - batch.size) {
+      impl_->dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    if (impl_->config.protocol == NetworkProtocol::kUdp) {
+      const auto datagram_begin = batch.datagram_ends.empty() ? 0 : batch.datagram_ends.back();
+      if (batch.size > datagram_begin && batch.size - datagram_begin + message_size > impl_->config.datagram_size) {
+        batch.datagram_ends.push_back(batch.size);
+      }
+    }
+    std::memcpy(batch.data.data() + batch.size, bytes.data(), message_size);
+    batch.size += message_size;
+    half_full = batch.size >= batch.data.size() / 2;
+  }
+
+  // wake the network thread early rather than waiting for the flush timer; only once per send, and only if it can send
+  if (half_full && impl_->state.load(std::memory_order_relaxed) != ClientState::kNotConnected &&
+      !impl_->send_requested.exchange(true, std::memory_order_relaxed)) {
+    asio::post(impl_->io, [impl = impl_.get()]() {
+      impl->send_requested.store(false, std::memory_order_relaxed);
+      impl->Send();
+    });
+  }
+}
+
+ClientState NetworkHandler::GetClientState() const { return impl_->state.load(std::memory_order_relaxed); }
+
+std::uint64_t NetworkHandler::Dropped() const { return impl_->dropped.load(std::memory_order_relaxed); }
+}  // namespace ara::log
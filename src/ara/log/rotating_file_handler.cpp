@@ -0,0 +1,220 @@
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+
+#include "ara/log/logging_handler.h"
+
+extern char** environ;
+
+namespace {
+ara::core::String ArchiveName(const ara::core::String& path, std::size_t index) {
+  return path + "." + std::to_string(index);
+}
+
+bool ArchiveExists(const ara::core::String& archive) {
+  return ::access(archive.c_str(), F_OK) == 0 || ::access((archive + ".gz").c_str(), F_OK) == 0;
+}
+}  // namespace
+
+namespace ara::log {
+BaseRotatingHandler::BaseRotatingHandler(const FileConfig& config, int fd)
+    : FileHandler{config, fd},
+      next_path_{config.path + ".next"},
+      segment_size_{0},
+      segment_start_time_{std::chrono::system_clock::now()} {
+  // the only stat of the segment; from here on its size is counted
+  if (struct stat st{}; ::fstat(fd, &st) == 0) {
+    segment_size_ = static_cast<std::size_t>(st.st_size);
+  }
+  worker_ = std::thread{&BaseRotatingHandler::RunWorker, this};
+}
+
+BaseRotatingHandler::~BaseRotatingHandler() {
+  Shutdown();
+  if (const auto fd = next_fd_.exchange(-1); fd >= 0) {
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && st.st_size == 0) {
+      ::unlink(next_path_.c_str());
+    }
+    ::close(fd);
+  }
+}
+
+void BaseRotatingHandler::Shutdown() {
+  FileHandler::Shutdown();
+  {
+    std::scoped_lock lock{worker_mutex_};
+    stopping_ = true;
+  }
+  worker_cv_.notify_one();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+bool BaseRotatingHandler::SwitchSegment() {
+  const auto fd = next_fd_.exchange(-1, std::memory_order_acquire);
+  if (fd < 0) {
+    return false;
+  }
+
+  const auto closed_fd = ReplaceFile(fd);
+  {
+    std::scoped_lock lock{worker_mutex_};
+    closed_segments_.emplace_back(closed_fd, segment_start_time_);
+  }
+  worker_cv_.notify_one();
+  segment_size_ = 0;
+  segment_start_time_ = std::chrono::system_clock::now();
+  return true;
+}
+
+std::size_t BaseRotatingHandler::SegmentSize() const { return segment_size_; }
+
+void BaseRotatingHandler::BeforeWrite(std::size_t size) {
+  if (ShouldRollover(size)) {
+    DoRollover();
+  }
+  segment_size_ += size;
+}
+
+void BaseRotatingHandler::RunWorker() {
+  OpenNextSegment();
+
+  std::unique_lock lock{worker_mutex_};
+  while (true) {
+    worker_cv_.wait(lock, [this]() { return stopping_ || !closed_segments_.empty(); });
+    if (closed_segments_.empty()) {
+      return;
+    }
+
+    const auto [fd, start_time] = closed_segments_.front();
+    closed_segments_.erase(closed_segments_.begin());
+    lock.unlock();
+
+    if (Config().sync_interval.count() > 0) {
+      ::fdatasync(fd);
+    }
+    ::close(fd);
+    const auto archive = Archive(start_time);
+    // the segment written since the switch becomes the current file at the configured path
+    std::rename(next_path_.c_str(), Config().path.c_str());
+    // compressing takes longest, so have the next segment ready first
+    OpenNextSegment();
+    if (!archive.empty() && Config().rotation.compress) {
+      Compress(archive);
+    }
+
+    lock.lock();
+  }
+}
+
+void BaseRotatingHandler::OpenNextSegment() {
+  if (const auto fd = OpenFile(next_path_); fd >= 0) {
+    next_fd_.store(fd, std::memory_order_release);
+  }
+}
+
+void BaseRotatingHandler::Compress(const core::String& file_name) const {
+  core::String program{"gzip"};
+  core::String force{"-f"};
+  core::String file{file_name};
+  char* argv[]{program.data(), force.data(), file.data(), nullptr};
+  if (pid_t pid; posix_spawnp(&pid, argv[0], nullptr, nullptr, argv, environ) == 0) {
+    int status;
+    ::waitpid(pid, &status, 0);
+  }
+}
+
+RotatingFileHandler::~RotatingFileHandler() { Shutdown(); }
+
+bool RotatingFileHandler::ShouldRollover(std::size_t size) {
+  return SegmentSize() > 0 && SegmentSize() + size > Config().rotation.max_bytes;
+}
+
+void RotatingFileHandler::DoRollover() { SwitchSegment(); }
+
+core::String RotatingFileHandler::Archive(std::chrono::system_clock::time_point) {
+  const auto& path = Config().path;
+  const auto backup_count = Config().rotation.backup_count;
+  if (backup_count == 0) {
+    std::remove(path.c_str());
+    return {};
+  }
+
+  // archives are numbered from 1 without gaps, so only the existing ones are shifted, not backup_count of them: path.i
+  // to path.i+1, renaming over (and so dropping) the oldest archive
+  std::size_t archives{0};
+  while (archives + 1 < backup_count && ArchiveExists(ArchiveName(path, archives + 1))) {
+    ++archives;
+  }
+  for (auto index = archives; index > 0; --index) {
+    for (const char* suffix : {"", ".gz"}) {
+      const auto from = ArchiveName(path, index) + suffix;
+      const auto to = ArchiveName(path, index + 1) + suffix;
+      std::rename(from.c_str(), to.c_str());
+    }
+  }
+  const auto archive = ArchiveName(path, 1);
+  std::rename(path.c_str(), archive.c_str());
+  return archive;
+}
+
+TimedRotatingFileHandler::TimedRotatingFileHandler(const FileConfig& config, int fd)
+    : BaseRotatingHandler{config, fd}, deadline_{NextDeadline()} {}
+
+TimedRotatingFileHandler::~TimedRotatingFileHandler() { Shutdown(); }
+
+bool TimedRotatingFileHandler::ShouldRollover(std::size_t) { return std::chrono::system_clock::now() >= deadline_; }
+
+void TimedRotatingFileHandler::DoRollover() {
+  if (SwitchSegment()) {
+    deadline_ = NextDeadline();
+  }
+}
+
+core::String TimedRotatingFileHandler::Archive(std::chrono::system_clock::time_point segment_start_time) {
+  const auto& path = Config().path;
+  const auto start_time = std::chrono::system_clock::to_time_t(segment_start_time);
+  std::tm tm{};
+  localtime_r(&start_time, &tm);
+  std::array<char, 32> suffix{};
+  std::strftime(suffix.data(), suffix.size(), ".%Y-%m-%d_%H-%M-%S", &tm);
+  const auto archive = path + suffix.data();
+  std::rename(path.c_str(), archive.c_str());
+
+  // the time suffix sorts chronologically, so the oldest archives come first
+  namespace fs = std::filesystem;
+  const fs::path file_path{path};
+  const auto prefix = file_path.filename().string() + ".";
+  const auto next_name = fs::path{path + ".next"}.filename().string();
+  core::Vector<fs::path> archives;
+  std::error_code error;
+  const auto directory = file_path.has_parent_path() ? file_path.parent_path() : fs::path{"."};
+  for (const auto& entry : fs::directory_iterator{directory, error}) {
+    const auto name = entry.path().filename().string();
+    if (name.starts_with(prefix) && name != next_name) {
+      archives.push_back(entry.path());
+    }
+  }
+  std::sort(archives.begin(), archives.end());
+  const auto backup_count = Config().rotation.backup_count;
+  for (std::size_t i{0}; i + backup_count < archives.size(); ++i) {
+    fs::remove(archives[i], error);
+  }
+  return backup_count == 0 ? core::String{} : archive;
+}
+
+std::chrono::system_clock::time_point TimedRotatingFileHandler::NextDeadline() const {
+  const auto interval = Config().rotation.interval;
+  const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+  return now - now.time_since_epoch() % interval + interval;
+}
+}  // namespace ara::log
@@ -0,0 +1,61 @@
+#include "ara/log/suppression_reporter.h"
+
+#include <pthread.h>
+
+#include "ara/log/logger_manager.h"
+
+namespace ara::log {
+SuppressionReporter::~SuppressionReporter() { Stop(); }
+
+void SuppressionReporter::Add(LogLimit& limit) {
+  std::scoped_lock lock{mutex_};
+  limits_.push_back(&limit);
+}
+
+void SuppressionReporter::Start(std::chrono::milliseconds interval) {
+  reporter_ = std::thread{&SuppressionReporter::Run, this, interval};
+  pthread_setname_np(reporter_.native_handle(), "ara_log_limit");
+}
+
+void SuppressionReporter::Stop() {
+  if (!reporter_.joinable()) {
+    return;
+  }
+  {
+    std::scoped_lock lock{mutex_};
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  reporter_.join();
+  Report();
+}
+
+void SuppressionReporter::Run(std::chrono::milliseconds interval) {
+  std::unique_lock lock{mutex_};
+  while (!wake_.wait_for(lock, interval, [this]() { return stopping_; })) {
+    lock.unlock();
+    Report();
+    lock.lock();
+  }
+}
+
+void SuppressionReporter::Report() {
+  core::Vector<LogLimit*> limits;
+  {
+    std::scoped_lock lock{mutex_};
+    limits = limits_;
+  }
+  // logging without the lock, as a limited statement in a handler could otherwise deadlock on Add()
+  for (auto* const limit : limits) {
+    const auto suppressed = limit->suppressed_.exchange(0, std::memory_order_relaxed);
+    if (suppressed == 0) {
+      continue;
+    }
+    if (const auto logger = LoggerManager::Instance().GetLogger(limit->handle_)) {
+      logger->get().WithLevel(limit->log_level_).WithLocation(limit->location_.file_name(),
+                                                             static_cast<int>(limit->location_.line()))
+          << "rate limit suppressed" << suppressed << "messages";
+    }
+  }
+}
+}  // namespace ara::log
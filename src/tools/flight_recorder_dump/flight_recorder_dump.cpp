@@ -0,0 +1,23 @@
+#include <cstdio>
+
+#include "ara/log/flight_recorder.h"
+
+/// @brief Write the messages recovered from a flight recorder file to stdout as a DLT stream, oldest first.
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    std::fprintf(stderr, "usage: %s <flight recorder file>\n", argv[0]);
+    return 2;
+  }
+
+  std::size_t count{0};
+  const auto result = ara::log::flight_recorder::Read(argv[1], [&count](ara::core::Span<const ara::core::Byte> message) {
+    std::fwrite(message.data(), 1, message.size(), stdout);
+    ++count;
+  });
+  if (!result) {
+    std::fprintf(stderr, "%s: %s\n", argv[1], result.Error().Message().data());
+    return 1;
+  }
+  std::fprintf(stderr, "%zu messages recovered\n", count);
+  return 0;
+}
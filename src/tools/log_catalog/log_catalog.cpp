@@ -0,0 +1,216 @@
+#include <elf.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace {
+/// @brief mangled name of ara::log::detail::CatalogEntry<MsgId>::kData, around the mangled MsgId
+constexpr std::string_view kEntryPrefix{"_ZN3ara3log6detail12CatalogEntryI"};
+constexpr std::string_view kEntrySuffix{"E5kDataE"};
+/// @brief mangled name of ara::log::Logger::LogModeled(), up to its parameters
+constexpr std::string_view kLogModeledPrefix{"_ZN3ara3log6Logger10LogModeled"};
+
+constexpr std::array<std::string_view, 7> kLogLevels{"OFF", "FATAL", "ERROR", "WARN", "INFO", "DEBUG", "VERBOSE"};
+
+struct Elf32 {
+  using Ehdr = Elf32_Ehdr;
+  using Shdr = Elf32_Shdr;
+  using Sym = Elf32_Sym;
+};
+
+struct Elf64 {
+  using Ehdr = Elf64_Ehdr;
+  using Shdr = Elf64_Shdr;
+  using Sym = Elf64_Sym;
+};
+
+template <typename T>
+std::optional<T> Read(const std::vector<char>& file, std::uint64_t offset) {
+  if (offset + sizeof(T) > file.size()) {
+    return std::nullopt;
+  }
+  T value;
+  std::memcpy(&value, file.data() + offset, sizeof value);
+  return value;
+}
+
+std::uint32_t ReadUint32(std::string_view entry, std::size_t offset) {
+  std::uint32_t value{0};
+  for (std::size_t i{0}; i < 4; ++i) {
+    value |= static_cast<std::uint32_t>(static_cast<unsigned char>(entry[offset + i])) << (i * 8);
+  }
+  return value;
+}
+
+/// @brief What the symbol tables of a binary tell about its modeled messages.
+struct Symbols {
+  /// @brief the catalog entries defined in the binary
+  std::vector<std::string_view> entries;
+  /// @brief whether the binary calls Logger::LogModeled(), that is logs modeled messages
+  bool logs_modeled{false};
+};
+
+/// @brief Return the catalog entries found in the symbol tables of an ELF file (which must match the host byte order).
+/// Both the full and the dynamic symbol table are read: an executable keeps its entries in the former only, which
+/// stripping removes, while a shared library also exports them in the latter.
+template <typename Elf>
+std::optional<Symbols> FindEntries(const std::vector<char>& file) {
+  const auto header = Read<typename Elf::Ehdr>(file, 0);
+  if (!header) {
+    return std::nullopt;
+  }
+  std::vector<typename Elf::Shdr> sections;
+  for (std::size_t i{0}; i < header->e_shnum; ++i) {
+    const auto section = Read<typename Elf::Shdr>(file, header->e_shoff + i * header->e_shentsize);
+    if (!section) {
+      return std::nullopt;
+    }
+    sections.push_back(*section);
+  }
+
+  Symbols found;
+  for (const auto& symbols : sections) {
+    if ((symbols.sh_type != SHT_SYMTAB && symbols.sh_type != SHT_DYNSYM) || symbols.sh_link >= sections.size()) {
+      continue;
+    }
+    const auto& names = sections[symbols.sh_link];
+    for (std::uint64_t offset{symbols.sh_offset}; offset + sizeof(typename Elf::Sym) <= symbols.sh_offset + symbols.sh_size;
+         offset += sizeof(typename Elf::Sym)) {
+      const auto symbol = Read<typename Elf::Sym>(file, offset);
+      if (!symbol || names.sh_offset + symbol->st_name >= file.size()) {
+        continue;
+      }
+      const std::string_view name{file.data() + names.sh_offset + symbol->st_name};
+      if (symbol->st_shndx == SHN_UNDEF) {
+        found.logs_modeled = found.logs_modeled || name.starts_with(kLogModeledPrefix);
+        continue;
+      }
+      if (symbol->st_shndx >= sections.size() || !name.starts_with(kEntryPrefix) || !name.ends_with(kEntrySuffix)) {
+        continue;
+      }
+      const auto& section = sections[symbol->st_shndx];
+      const auto data_offset = section.sh_offset + (symbol->st_value - section.sh_addr);
+      if (section.sh_type == SHT_NOBITS || data_offset + symbol->st_size > file.size()) {
+        continue;
+      }
+      found.entries.emplace_back(file.data() + data_offset, symbol->st_size);
+    }
+  }
+  return found;
+}
+
+/// @brief Decode a catalog entry, laid out as written by ara::log::detail::MakeCatalogEntry().
+std::optional<nlohmann::json> DecodeEntry(std::string_view entry) {
+  if (entry.size() < 10 || ReadUint32(entry, 0) != entry.size()) {
+    return std::nullopt;
+  }
+  const auto id = ReadUint32(entry, 4);
+  const auto log_level = static_cast<std::size_t>(entry[8]);
+  const auto number_of_arguments = static_cast<std::size_t>(static_cast<unsigned char>(entry[9]));
+  entry.remove_prefix(10);
+
+  const auto next_string = [&entry]() -> std::optional<std::string> {
+    const auto end = entry.find('\0');
+    if (end == std::string_view::npos) {
+      return std::nullopt;
+    }
+    std::string value{entry.substr(0, end)};
+    entry.remove_prefix(end + 1);
+    return value;
+  };
+
+  const auto format = next_string();
+  if (!format || log_level >= kLogLevels.size()) {
+    return std::nullopt;
+  }
+  auto arguments = nlohmann::json::array();
+  for (std::size_t i{0}; i < number_of_arguments; ++i) {
+    const auto type = next_string();
+    const auto name = next_string();
+    const auto unit = next_string();
+    if (!type || !name || !unit) {
+      return std::nullopt;
+    }
+    arguments.push_back({{"name", *name}, {"unit", *unit}, {"type", *type}});
+  }
+  return nlohmann::json{
+      {"id", id}, {"level", kLogLevels[log_level]}, {"format", *format}, {"arguments", std::move(arguments)}};
+}
+}  // namespace
+
+/// @brief Export the catalog of the modeled (non-verbose) messages logged by executables and shared libraries as JSON.
+/// A decoder renders non-verbose messages from it: the message id selects the entry, whose argument types give the
+/// encoding of the payload and whose format, names and units describe the values. The binaries of one application go
+/// into one catalog, so their message ids must not collide.
+int main(int argc, char* argv[]) {
+  std::vector<const char*> binaries{argv + 1, argv + argc};
+  const char* output_path{nullptr};
+  if (binaries.size() >= 2 && std::string_view{binaries[0]} == "-o") {
+    output_path = binaries[1];
+    binaries.erase(binaries.begin(), binaries.begin() + 2);
+  }
+  if (binaries.empty()) {
+    std::fprintf(stderr, "usage: %s [-o <catalog.json>] <binary>...\n", argv[0]);
+    return 2;
+  }
+
+  std::map<std::uint32_t, nlohmann::json> messages;
+  for (const auto* const binary : binaries) {
+    std::ifstream input{binary, std::ios::binary};
+    const std::vector<char> file{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+    if (file.size() < EI_NIDENT || std::memcmp(file.data(), ELFMAG, SELFMAG) != 0) {
+      std::fprintf(stderr, "%s: not an ELF file\n", binary);
+      return 1;
+    }
+    const auto symbols = file[EI_CLASS] == ELFCLASS64 ? FindEntries<Elf64>(file) : FindEntries<Elf32>(file);
+    if (!symbols) {
+      std::fprintf(stderr, "%s: malformed ELF file\n", binary);
+      return 1;
+    }
+    // an empty catalog would leave its messages undecodable without anyone noticing
+    if (symbols->logs_modeled && symbols->entries.empty()) {
+      std::fprintf(stderr, "%s: logs modeled messages, but has no catalog entries; is it stripped?\n", binary);
+      return 1;
+    }
+
+    for (const auto entry : symbols->entries) {
+      auto message = DecodeEntry(entry);
+      if (!message) {
+        std::fprintf(stderr, "%s: malformed catalog entry\n", binary);
+        return 1;
+      }
+      const auto id = (*message)["id"].get<std::uint32_t>();
+      if (const auto [it, inserted] = messages.emplace(id, *message); !inserted && it->second != *message) {
+        std::fprintf(stderr, "%s: message id 0x%x is used by different messages\n", binary, id);
+        return 1;
+      }
+    }
+  }
+
+  nlohmann::json catalog{{"messages", nlohmann::json::array()}};
+  for (auto& [id, message] : messages) {
+    catalog["messages"].push_back(std::move(message));
+  }
+  if (!output_path) {
+    std::printf("%s\n", catalog.dump(2).c_str());
+    return 0;
+  }
+  std::ofstream output{output_path};
+  output << catalog.dump(2) << '\n';
+  if (!output) {
+    std::fprintf(stderr, "%s: cannot write\n", output_path);
+    return 1;
+  }
+  return 0;
+}
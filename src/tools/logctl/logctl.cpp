@@ -0,0 +1,118 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+#include "ara/log/control_protocol.h"
+#include "ara/log/log_error_domain.h"
+
+namespace {
+constexpr std::array<const char*, 7> kLevelNames{"OFF", "FATAL", "ERROR", "WARN", "INFO", "DEBUG", "VERBOSE"};
+
+bool ParseLevel(const char* name, ara::log::LogLevel& level) {
+  for (std::size_t i{0}; i < kLevelNames.size(); ++i) {
+    if (std::strcmp(name, kLevelNames[i]) == 0) {
+      level = static_cast<ara::log::LogLevel>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+const char* LevelName(ara::log::LogLevel level) { return kLevelNames[static_cast<std::size_t>(level)]; }
+
+int Usage(const char* program) {
+  std::fprintf(stderr,
+               "usage: %s <socket> get-contexts [<ctx id>]\n"
+               "       %s <socket> set-level <ctx id>|all <level>\n"
+               "       %s <socket> get-default-level\n"
+               "       %s <socket> set-default-level <level>\n"
+               "levels: OFF FATAL ERROR WARN INFO DEBUG VERBOSE\n",
+               program, program, program, program);
+  return 2;
+}
+
+/// @brief Send a request to the control socket at path and wait for its response.
+ara::core::Result<ara::log::control::Response> Exchange(const char* path, const ara::log::control::Request& request) {
+  using R = ara::core::Result<ara::log::control::Response>;
+
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (std::strlen(path) >= sizeof(address.sun_path)) {
+    return R::FromError(ara::log::LogErrc::kOpenControlChannelFailed);
+  }
+  std::strcpy(address.sun_path, path);
+
+  const int fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    return R::FromError(ara::log::LogErrc::kOpenControlChannelFailed);
+  }
+
+  const auto message = ara::log::control::Serialize(request);
+  ara::core::Vector<ara::core::Byte> response(ara::log::control::kMaxMessageSize);
+  ssize_t size{-1};
+  if (::send(fd, message.data(), message.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(message.size())) {
+    size = ::recv(fd, response.data(), response.size(), 0);
+  }
+  ::close(fd);
+  if (size <= 0) {
+    return R::FromError(ara::log::LogErrc::kOpenControlChannelFailed);
+  }
+  return ara::log::control::ParseResponse({response.data(), static_cast<std::size_t>(size)});
+}
+}  // namespace
+
+/// @brief Query and change the log levels of a running process over its control socket (see "Control" in the
+/// manifest).
+int main(int argc, char* argv[]) {
+  using ara::log::control::ServiceId;
+  using ara::log::control::Status;
+
+  if (argc < 3) {
+    return Usage(argv[0]);
+  }
+  const char* const path = argv[1];
+  const char* const command = argv[2];
+
+  ara::log::control::Request request{ServiceId::kGetLogInfo};
+  if (std::strcmp(command, "get-contexts") == 0 && argc <= 4) {
+    request.ctx_id = argc == 4 ? argv[3] : "";
+  } else if (std::strcmp(command, "set-level") == 0 && argc == 5 && ParseLevel(argv[4], request.log_level)) {
+    request.service = ServiceId::kSetLogLevel;
+    request.ctx_id = std::strcmp(argv[3], "all") == 0 ? "" : argv[3];
+  } else if (std::strcmp(command, "get-default-level") == 0 && argc == 3) {
+    request.service = ServiceId::kGetDefaultLogLevel;
+  } else if (std::strcmp(command, "set-default-level") == 0 && argc == 4 && ParseLevel(argv[3], request.log_level)) {
+    request.service = ServiceId::kSetDefaultLogLevel;
+  } else {
+    return Usage(argv[0]);
+  }
+
+  const auto response = Exchange(path, request);
+  if (!response) {
+    std::fprintf(stderr, "%s: %s\n", path, response.Error().Message().data());
+    return 1;
+  }
+  if (response.Value().status != Status::kOk) {
+    std::fprintf(stderr, "%s: %s\n", command,
+                 response.Value().status == Status::kNotSupported ? "not supported" : "rejected");
+    return 1;
+  }
+
+  if (request.service == ServiceId::kGetLogInfo) {
+    std::printf("%s\n", response.Value().app_id.c_str());
+    for (const auto& context : response.Value().contexts) {
+      std::printf("  %-4s %-7s %s\n", context.ctx_id.c_str(), LevelName(context.log_level),
+                  context.description.c_str());
+    }
+  } else if (request.service == ServiceId::kGetDefaultLogLevel) {
+    std::printf("%s\n", LevelName(response.Value().log_level));
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/core/initialization.h"
+#include "ara/log/logger.h"
+#include "ara/log/logger_manager.h"
+#include "ara/log/logging_handler.h"
+#include "test_util.h"
+
+namespace {
+using ara::log::LogLevel;
+
+/// @brief Write the buffered messages of the file sink and return the lines of the file, as "<context>|<level>|<text>".
+std::vector<std::string> ReadLog() {
+  for (const auto& handler : ara::log::LoggerManager::Instance().GetLoggingHandlers()) {
+    dynamic_cast<ara::log::FileHandler&>(*handler).Flush();
+  }
+  std::vector<std::string> lines;
+  std::ifstream file{"backtrace.log"};
+  for (std::string line; std::getline(file, line);) {
+    // skip the timestamp, ECU and application ids, and the process id in front of the level
+    std::size_t context{0};
+    for (int field{0}; field < 3; ++field) {
+      context = line.find('|', context) + 1;
+    }
+    const auto pid = line.find('|', context);
+    const auto level = line.find('|', pid + 1);
+    lines.push_back(line.substr(context, pid - context) + line.substr(level, line.find_last_not_of(' ') + 1 - level));
+  }
+  return lines;
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "TEST", "File": {"Path": "backtrace.log"},
+                              "Backtrace": {"Level": "DEBUG", "Contexts": ["BT1", "BT2"], "Depth": 4}})");
+  ::unlink("backtrace.log");
+  VITO_AP_CHECK(ara::core::Initialize().HasValue());
+
+  auto& first = ara::log::CreateLogger("BT1", "backtrace test", LogLevel::kInfo);
+  auto& second = ara::log::CreateLogger("BT2", "backtrace test", LogLevel::kInfo);
+  auto& other = ara::log::CreateLogger("OTH", "not in backtrace mode", LogLevel::kInfo);
+
+  // captured, but not emitted until an error
+  VITO_AP_CHECK(first.IsEnabled(LogLevel::kDebug) && !first.IsEnabled(LogLevel::kVerbose));
+  VITO_AP_CHECK(!other.IsEnabled(LogLevel::kDebug));
+  for (std::uint32_t i{0}; i < 6; ++i) {
+    first.LogDebug() << "debug" << i;
+  }
+  first.LogInfo() << "info";
+  second.LogDebug() << "debug" << std::uint32_t{6};
+  other.LogDebug() << "not captured";
+  // the ring of another thread is not dumped by this one's errors
+  std::thread{[&first]() { first.LogDebug() << "other thread"; }}.join();
+  VITO_AP_CHECK((ReadLog() == std::vector<std::string>{"BT1|INFO|info"}));
+
+  // the last Depth captured messages of all contexts of the thread, oldest first, in front of the error
+  first.LogError() << "failure";
+  VITO_AP_CHECK((ReadLog() == std::vector<std::string>{"BT1|INFO|info", "BT1|DEBUG|debug 3", "BT1|DEBUG|debug 4",
+                                                       "BT1|DEBUG|debug 5", "BT2|DEBUG|debug 6", "BT1|ERROR|failure"}));
+
+  // the dump emptied the ring
+  second.LogFatal() << "second failure";
+  auto lines = ReadLog();
+  VITO_AP_CHECK(lines.size() == 7 && lines.back() == "BT2|FATAL|second failure");
+
+  // a partly filled ring
+  second.LogDebug() << "debug" << std::uint32_t{7};
+  other.LogError() << "third failure";
+  lines = ReadLog();
+  VITO_AP_CHECK(lines.size() == 9);
+  if (lines.size() == 9) {
+    VITO_AP_CHECK(lines[7] == "BT2|DEBUG|debug 7" && lines[8] == "OTH|ERROR|third failure");
+  }
+
+  VITO_AP_CHECK(ara::core::Deinitialize().HasValue());
+  return ara::test::Result();
+}
@@ -0,0 +1,64 @@
+#ifndef VITO_AP_BENCH_UTIL_H_
+#define VITO_AP_BENCH_UTIL_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+namespace ara::bench {
+/// @brief Keep the compiler from optimizing away the computation of value.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "m"(value) : "memory");
+}
+
+/// @brief Run body iterations times, after a tenth of that as warm-up, and print the mean time per iteration.
+/// @return the mean time per iteration in nanoseconds
+template <typename F>
+double Measure(const char* name, std::size_t iterations, F&& body) {
+  for (std::size_t i{0}; i < iterations / 10; ++i) {
+    body();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i{0}; i < iterations; ++i) {
+    body();
+  }
+  const std::chrono::duration<double, std::nano> elapsed{std::chrono::steady_clock::now() - start};
+  const auto mean = elapsed.count() / static_cast<double>(iterations);
+  std::printf("%-40s %10.1f ns/op\n", name, mean);
+  return mean;
+}
+
+/// @brief Latencies of single operations, summarized as percentiles, which show the stalls a mean hides.
+class Latencies {
+ public:
+  explicit Latencies(std::size_t capacity) { samples_.reserve(capacity); }
+
+  template <typename F>
+  void Time(F&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    samples_.push_back(std::chrono::duration<double, std::nano>{std::chrono::steady_clock::now() - start}.count());
+  }
+
+  /// @brief Print the median, the 99th and 99.9th percentiles and the maximum, in nanoseconds.
+  void Print(const char* name) {
+    if (samples_.empty()) {
+      return;
+    }
+    std::sort(samples_.begin(), samples_.end());
+    const auto at = [this](double quantile) {
+      return samples_[std::min(samples_.size() - 1, static_cast<std::size_t>(quantile * samples_.size()))];
+    };
+    std::printf("%-40s p50 %8.0f  p99 %8.0f  p99.9 %8.0f  max %10.0f ns\n", name, at(0.5), at(0.99), at(0.999),
+                samples_.back());
+  }
+
+ private:
+  std::vector<double> samples_;
+};
+}  // namespace ara::bench
+
+#endif  // !VITO_AP_BENCH_UTIL_H_
@@ -0,0 +1,46 @@
+#include <cstdio>
+#include <string>
+
+#include "ara/log/log_clock.h"
+#include "bench_util.h"
+
+namespace {
+constexpr std::size_t kIterations{10'000'000};
+
+struct Source {
+  const char* name;
+  ara::log::ClockSource clock_source;
+};
+}  // namespace
+
+int main() {
+  using ara::log::ClockSource;
+  using ara::log::TimeSource;
+
+  // the producer pays for Now(); ToRealtime() is paid once per rendered or serialized message
+  for (const auto& [name, clock_source] : {Source{"REALTIME", ClockSource::kRealtime},
+                                           Source{"REALTIME_COARSE", ClockSource::kRealtimeCoarse},
+                                           Source{"MONOTONIC", ClockSource::kMonotonic},
+                                           Source{"MONOTONIC_COARSE", ClockSource::kMonotonicCoarse},
+                                           Source{"TSC", ClockSource::kTsc}}) {
+    auto& time_source = TimeSource::Instance();
+    time_source.Init(clock_source);
+
+    // the converted time must stay close to CLOCK_REALTIME, coarse clocks lagging by up to a tick
+    const auto realtime = ara::log::RealtimeClock::now().time_since_epoch().count();
+    const auto converted = static_cast<std::int64_t>(time_source.ToRealtime(time_source.Now()));
+    if (converted - realtime > 10'000'000 || realtime - converted > 10'000'000) {
+      std::fprintf(stderr, "%s is %lld ns off CLOCK_REALTIME\n", name, static_cast<long long>(converted - realtime));
+      return 1;
+    }
+
+    ara::bench::Measure((std::string{name} + " Now()").c_str(), kIterations, [&] {
+      ara::bench::DoNotOptimize(time_source.Now());
+    });
+    const auto raw = time_source.Now();
+    ara::bench::Measure((std::string{name} + " ToRealtime()").c_str(), kIterations, [&] {
+      ara::bench::DoNotOptimize(time_source.ToRealtime(raw));
+    });
+  }
+  return 0;
+}
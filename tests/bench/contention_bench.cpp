@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "ara/core/initialization.h"
+#include "ara/log/logger.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+namespace {
+constexpr std::size_t kLinesPerThread{200'000};
+
+/// @brief Log ten-argument lines from threads threads at once and print the time per line and the total throughput.
+/// Without a shared lock on the argument path the time per line stays about the same as threads are added while there
+/// are cores for them, and the total throughput stays about the same beyond that.
+void Run(ara::log::Logger& logger, std::size_t threads) {
+  std::vector<std::thread> producers;
+  std::vector<double> nanoseconds(threads);
+  for (std::size_t t{0}; t < threads; ++t) {
+    producers.emplace_back([&logger, &nanoseconds, t] {
+      const auto start = std::chrono::steady_clock::now();
+      for (std::uint32_t i{0}; i < kLinesPerThread; ++i) {
+        logger.LogInfo() << "line" << i << t << 1.5 << "of" << kLinesPerThread << true << 'x' << -1 << "end";
+      }
+      nanoseconds[t] = std::chrono::duration<double, std::nano>{std::chrono::steady_clock::now() - start}.count();
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  const auto slowest = *std::max_element(nanoseconds.begin(), nanoseconds.end());
+  std::printf("%2zu thread(s): %8.1f ns/line per thread, %8.2f M lines/s in total\n", threads,
+              slowest / kLinesPerThread, static_cast<double>(threads * kLinesPerThread) / slowest * 1e3);
+}
+}  // namespace
+
+int main() {
+  // the flight recorder takes messages without a lock, so the sink does not serialize the producers either
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FLIGHT_RECORDER"], "AppId": "BNCH"})");
+  if (!ara::core::Initialize()) {
+    return 1;
+  }
+
+  auto& logger = ara::log::CreateLogger("CONT", "contention", ara::log::LogLevel::kInfo);
+  for (std::size_t threads{1}; threads <= 8; threads *= 2) {
+    Run(logger, threads);
+  }
+
+  return ara::core::Deinitialize() ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+#include "ara/core/initialization.h"
+#include "ara/log/logger.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+namespace {
+constexpr std::size_t kIterations{10'000'000};
+
+struct Sample : ara::log::ModeledMessage<0x10, ara::log::LogLevel::kDebug, std::uint32_t, double> {
+  static constexpr ara::core::StringView kFormat{"sample {} value {}"};
+  static constexpr std::array<ara::log::ArgumentInfo, 2> kArguments{{{"sample", ""}, {"value", ""}}};
+};
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "BNCH"})");
+  if (!ara::core::Initialize()) {
+    return 1;
+  }
+
+  auto& logger = ara::log::CreateLogger("DIS", "disabled levels", ara::log::LogLevel::kInfo);
+  const ara::core::String text{"a string long enough not to fit the small string buffer"};
+  std::uint32_t i{0};
+  ara::bench::Measure("disabled LogDebug", kIterations, [&] { logger.LogDebug() << "value" << ++i << 0.5 << text; });
+  ara::bench::Measure("disabled WithLevel", kIterations,
+                      [&] { logger.WithLevel(ara::log::LogLevel::kDebug) << "value" << ++i << 0.5 << text; });
+  ara::bench::Measure("disabled modeled message", kIterations, [&] { logger.Log(Sample{}, ++i, 0.5); });
+  // for comparison: the same statement when the level is enabled, written to the file sink
+  ara::bench::Measure("enabled LogInfo", kIterations / 10, [&] { logger.LogInfo() << "value" << ++i << 0.5 << text; });
+
+  return ara::core::Deinitialize() ? 0 : 1;
+}
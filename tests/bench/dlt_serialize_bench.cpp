@@ -0,0 +1,40 @@
+#include <array>
+
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_config.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+
+constexpr std::size_t kIterations{1'000'000};
+
+std::shared_ptr<dlt::Message> MakeMessage() {
+  auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "BNCH");
+  (void)message->AddArgument(core::StringView{"request served in"});
+  (void)message->AddArgument(std::uint32_t{1234});
+  (void)message->AddArgument(std::uint64_t{0xDEAD'BEEF}, ArgumentAttributes{"id", nullptr, {Fmt::kHex, 8}});
+  (void)message->AddArgument(0.25, ArgumentAttributes{"load", "%", {Fmt::kDefault, 0}});
+  return message;
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["CONSOLE"], "AppId": "BNCH"})");
+  if (!LogConfig::Instance().Init("MANIFEST.json")) {
+    return 1;
+  }
+
+  bench::Measure("build verbose message", kIterations, [] { bench::DoNotOptimize(MakeMessage()); });
+
+  const auto message = MakeMessage();
+  std::array<core::Byte, 512> out{};
+  bench::Measure("SerializeTo", kIterations, [&message, &out] {
+    bench::DoNotOptimize(message->SerializeTo(out));
+    bench::DoNotOptimize(out);
+  });
+  bench::Measure("build and Serialized", kIterations, [] { bench::DoNotOptimize(MakeMessage()->Serialized().size()); });
+  return 0;
+}
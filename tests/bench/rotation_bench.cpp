@@ -0,0 +1,74 @@
+#include <filesystem>
+
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logging_handler.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+
+constexpr std::size_t kMessages{200'000};
+/// @brief small enough for the run to roll over a few dozen times
+constexpr std::size_t kSegmentSize{1 << 20};
+
+/// @brief Time each Emit() of kMessages text messages, which are built outside of the timed part.
+/// @return false if the file cannot be opened
+bool Run(const char* name, core::Result<std::unique_ptr<FileHandler>> opened) {
+  if (!opened) {
+    std::fprintf(stderr, "%s: cannot open the file\n", name);
+    return false;
+  }
+  auto handler = std::move(opened).Value();
+  bench::Latencies latencies{kMessages};
+  for (std::uint32_t i{0}; i < kMessages; ++i) {
+    auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "ROT");
+    (void)message->AddArgument(core::StringView{"a message of about a hundred bytes, number"});
+    (void)message->AddArgument(i);
+    latencies.Time([&handler, &message] { handler->Emit(std::move(message)); });
+  }
+  // closing the handler finishes the pending archiving, so all segments are counted below
+  handler.reset();
+  latencies.Print(name);
+  return true;
+}
+
+/// @brief Count and remove the file at path and its archives.
+std::size_t RemoveSegments(const core::String& path) {
+  std::size_t segments{0};
+  for (const auto& entry : std::filesystem::directory_iterator{"."}) {
+    if (entry.path().filename().string().starts_with(path)) {
+      std::filesystem::remove(entry.path());
+      ++segments;
+    }
+  }
+  return segments;
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "BNCH"})");
+  if (!LogConfig::Instance().Init("MANIFEST.json")) {
+    return 1;
+  }
+
+  FileConfig config;
+  config.buffer_size = 1 << 16;
+  config.path = "plain.log";
+  if (!Run("FileHandler", FileHandler::Open(config))) {
+    return 1;
+  }
+  RemoveSegments(config.path);
+
+  // keep every archive, to count the rollovers
+  config.path = "rotating.log";
+  config.rotation.max_bytes = kSegmentSize;
+  config.rotation.backup_count = 1000;
+  if (!Run("RotatingFileHandler, 1 MiB segments", FileHandler::Open<RotatingFileHandler>(config))) {
+    return 1;
+  }
+  std::printf("%zu segments written\n", RemoveSegments(config.path));
+  return 0;
+}
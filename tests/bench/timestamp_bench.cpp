@@ -0,0 +1,56 @@
+#include <ctime>
+#include <iterator>
+
+#include "ara/log/dlt_message.h"
+#include "bench_util.h"
+#include "fmt/chrono.h"
+
+namespace {
+constexpr std::size_t kIterations{1'000'000};
+
+/// @brief The rendering Timestamp used before the calendar cache: localtime and a strftime-style pass per message.
+void FormatWithLocaltime(const ara::log::dlt::Timestamp& timestamp, ara::core::String& out) {
+  fmt::format_to(std::back_inserter(out), "{:%Y-%m-%d %H:%M:%S}.{:0>9}",
+                 fmt::localtime(static_cast<std::time_t>(timestamp.Seconds())), timestamp.Nanoseconds());
+}
+}  // namespace
+
+int main() {
+  using ara::log::dlt::Timestamp;
+
+  const Timestamp timestamp;
+  ara::core::String cached;
+  ara::core::String reference;
+  timestamp.FormatTo(cached);
+  FormatWithLocaltime(timestamp, reference);
+  if (cached != reference) {
+    std::fprintf(stderr, "renderings differ: %s and %s\n", cached.c_str(), reference.c_str());
+    return 1;
+  }
+
+  ara::core::String out;
+  out.reserve(64);
+  // the same second over and over, as for a burst of messages
+  ara::bench::Measure("localtime, same second", kIterations, [&] {
+    out.clear();
+    FormatWithLocaltime(timestamp, out);
+    ara::bench::DoNotOptimize(out);
+  });
+  ara::bench::Measure("cached calendar, same second", kIterations, [&] {
+    out.clear();
+    timestamp.FormatTo(out);
+    ara::bench::DoNotOptimize(out);
+  });
+  // a fresh timestamp per message, including the clock read, so the seconds roll over as they do in use
+  ara::bench::Measure("localtime, fresh timestamp", kIterations, [&] {
+    out.clear();
+    FormatWithLocaltime(Timestamp{}, out);
+    ara::bench::DoNotOptimize(out);
+  });
+  ara::bench::Measure("cached calendar, fresh timestamp", kIterations, [&] {
+    out.clear();
+    Timestamp{}.FormatTo(out);
+    ara::bench::DoNotOptimize(out);
+  });
+  return 0;
+}
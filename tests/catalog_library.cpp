@@ -0,0 +1,11 @@
+#include "ara/log/logger.h"
+
+namespace catalog_test {
+/// @brief A modeled message logged from a shared library rather than the executable.
+struct LibraryMessage : ara::log::ModeledMessage<0x200, ara::log::LogLevel::kWarn, std::uint16_t> {
+  static constexpr ara::core::StringView kFormat{"library sample {}"};
+  static constexpr std::array<ara::log::ArgumentInfo, 1> kArguments{{{"sample", ""}}};
+};
+
+void LogLibraryMessage(ara::log::Logger& logger) { logger.Log(LibraryMessage{}, std::uint16_t{7}); }
+}  // namespace catalog_test
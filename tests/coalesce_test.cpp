@@ -0,0 +1,91 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/core/initialization.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logger.h"
+#include "ara/log/logger_manager.h"
+#include "ara/log/logging_handler.h"
+#include "test_util.h"
+
+namespace {
+using namespace std::chrono_literals;
+
+/// @brief Write the buffered messages of the file sink and return the lines of the file.
+std::vector<std::string> ReadLog() {
+  for (const auto& handler : ara::log::LoggerManager::Instance().GetLoggingHandlers()) {
+    dynamic_cast<ara::log::FileHandler&>(*handler).Flush();
+  }
+  std::vector<std::string> lines;
+  std::ifstream file{"coalesce.log"};
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+/// @brief Wait until the file has at least count lines, for at most five seconds.
+std::vector<std::string> WaitForLines(std::size_t count) {
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  auto lines = ReadLog();
+  while (lines.size() < count && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(10ms);
+    lines = ReadLog();
+  }
+  return lines;
+}
+
+bool Contains(const std::string& line, const std::string& text) { return line.find(text) != std::string::npos; }
+}  // namespace
+
+int main() {
+  // coalescing runs on the writer thread, so it is rejected without the asynchronous mode
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "TEST",
+                              "Coalesce": {"Enabled": true}})");
+  VITO_AP_CHECK(!ara::log::LogConfig::Instance().Init("MANIFEST.json").HasValue());
+
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "TEST", "Async": {"Enabled": true},
+                              "File": {"Path": "coalesce.log"}, "Coalesce": {"Enabled": true, "WindowMs": 500}})");
+  ::unlink("coalesce.log");
+  VITO_AP_CHECK(ara::core::Initialize().HasValue());
+
+  auto& logger = ara::log::CreateLogger("COAL", "coalesce test", ara::log::LogLevel::kInfo);
+  for (std::uint32_t i{0}; i < 50; ++i) {
+    logger.LogWarn() << "sensor" << std::uint32_t{7} << "timed out";
+  }
+  // other arguments, so another message
+  logger.LogWarn() << "sensor" << std::uint32_t{8} << "timed out";
+
+  // the first occurrences only, until the window ends
+  auto lines = WaitForLines(2);
+  VITO_AP_CHECK(lines.size() == 2);
+  if (lines.size() == 2) {
+    VITO_AP_CHECK(Contains(lines[0], "|sensor 7 timed out ") && !Contains(lines[0], "repeated"));
+    VITO_AP_CHECK(Contains(lines[1], "|sensor 8 timed out ") && !Contains(lines[1], "repeated"));
+  }
+
+  // the record is emitted once the window has ended, without another message coming
+  lines = WaitForLines(3);
+  VITO_AP_CHECK(lines.size() == 3);
+  if (lines.size() == 3) {
+    VITO_AP_CHECK(Contains(lines[2], "|WARN|sensor 7 timed out repeated=49 times "));
+  }
+
+  // a new window, closed by Deinitialize()
+  for (std::uint32_t i{0}; i < 3; ++i) {
+    logger.LogWarn() << "sensor" << std::uint32_t{7} << "timed out";
+  }
+  VITO_AP_CHECK(ara::core::Deinitialize().HasValue());
+  lines = ReadLog();
+  VITO_AP_CHECK(lines.size() == 5);
+  if (lines.size() == 5) {
+    VITO_AP_CHECK(Contains(lines[3], "|sensor 7 timed out ") && !Contains(lines[3], "repeated"));
+    VITO_AP_CHECK(Contains(lines[4], "|sensor 7 timed out repeated=2 times "));
+  }
+  return ara::test::Result();
+}
@@ -0,0 +1,90 @@
+#include "ara/log/context_registry.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/log/log_config.h"
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+
+/// @brief more than the first chunks and the first index table hold, so that both grow; a prime, so that every stride
+/// visits all contexts
+constexpr std::size_t kContexts{2503};
+constexpr std::size_t kThreads{8};
+
+std::string CtxId(std::size_t i) { return "C" + std::to_string(i); }
+
+void TestLookup() {
+  ContextRegistry contexts;
+  auto& first = contexts.GetOrCreate("CTX1", "first context", LogLevel::kInfo);
+  auto& second = contexts.GetOrCreate("CTX2", "second context", LogLevel::kDebug);
+
+  // handles are dense, in creation order
+  VITO_AP_CHECK(first.GetContextHandle() == 0 && second.GetContextHandle() == 1);
+  VITO_AP_CHECK(contexts.Size() == 2);
+
+  // an existing context is returned as it is, description and threshold included
+  auto& again = contexts.GetOrCreate("CTX1", "other description", LogLevel::kVerbose);
+  VITO_AP_CHECK(&again == &first && contexts.Size() == 2);
+  const auto info = contexts.Info(first.GetContextHandle());
+  VITO_AP_CHECK(info && info->ctx_id == "CTX1" && info->ctx_desc == "first context" &&
+                info->threshold == LogLevel::kInfo);
+
+  VITO_AP_CHECK(contexts.Find("CTX2") == &second && contexts.Find(ContextHandle{1}) == &second);
+  VITO_AP_CHECK(contexts.Find("CTX3") == nullptr && contexts.Find(ContextHandle{2}) == nullptr);
+  VITO_AP_CHECK(!contexts.Info(ContextHandle{2}));
+}
+
+void TestConcurrentCreation() {
+  ContextRegistry contexts;
+  // each thread creates and looks up all contexts, in an order of its own, while the others add theirs
+  std::vector<std::vector<Logger*>> created(kThreads, std::vector<Logger*>(kContexts));
+  std::vector<std::thread> threads;
+  for (std::size_t t{0}; t < kThreads; ++t) {
+    threads.emplace_back([&contexts, &created, t]() {
+      for (std::size_t n{0}; n < kContexts; ++n) {
+        const auto i = (n * (2 * t + 1)) % kContexts;
+        created[t][i] = &contexts.GetOrCreate(CtxId(i), "concurrent context", LogLevel::kInfo);
+        if (contexts.Find(CtxId(i)) != created[t][i]) {
+          created[t][i] = nullptr;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // one context per id, whichever thread created it
+  VITO_AP_CHECK(contexts.Size() == kContexts);
+  std::vector<bool> handles(kContexts);
+  for (std::size_t i{0}; i < kContexts; ++i) {
+    auto* const logger = created[0][i];
+    for (std::size_t t{1}; t < kThreads; ++t) {
+      VITO_AP_CHECK(created[t][i] == logger);
+    }
+    if (!logger) {
+      continue;
+    }
+    const auto handle = logger->GetContextHandle();
+    const auto info = contexts.Info(handle);
+    VITO_AP_CHECK(info && info->ctx_id == CtxId(i));
+    VITO_AP_CHECK(handle < kContexts && !handles[handle] && contexts.Find(handle) == logger);
+    if (handle < kContexts) {
+      handles[handle] = true;
+    }
+  }
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["CONSOLE"], "AppId": "TEST"})");
+  VITO_AP_CHECK(LogConfig::Instance().Init("MANIFEST.json").HasValue());
+  TestLookup();
+  TestConcurrentCreation();
+  return ara::test::Result();
+}
@@ -0,0 +1,144 @@
+#include "ara/log/control_protocol.h"
+
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+using namespace ara::log::control;
+
+/// @brief offset of the LEN field in the base header
+constexpr std::size_t kLengthOffset{5};
+
+core::Vector<core::Byte> WithLength(core::Vector<core::Byte> message, std::size_t length) {
+  message[kLengthOffset] = static_cast<core::Byte>(length >> 8);
+  message[kLengthOffset + 1] = static_cast<core::Byte>(length);
+  return message;
+}
+
+void TestRequestRoundTrip() {
+  const Request set_level{ServiceId::kSetLogLevel, "APP1", "CTX1", LogLevel::kDebug};
+  const auto parsed_set_level = ParseRequest(Serialize(set_level));
+  VITO_AP_CHECK(parsed_set_level.HasValue());
+  if (parsed_set_level) {
+    VITO_AP_CHECK(parsed_set_level.Value().service == ServiceId::kSetLogLevel);
+    VITO_AP_CHECK(parsed_set_level.Value().app_id == "APP1");
+    VITO_AP_CHECK(parsed_set_level.Value().ctx_id == "CTX1");
+    VITO_AP_CHECK(parsed_set_level.Value().log_level == LogLevel::kDebug);
+  }
+
+  // empty ids address all applications and contexts
+  const auto parsed_get_info = ParseRequest(Serialize(Request{ServiceId::kGetLogInfo}));
+  VITO_AP_CHECK(parsed_get_info.HasValue());
+  if (parsed_get_info) {
+    VITO_AP_CHECK(parsed_get_info.Value().service == ServiceId::kGetLogInfo);
+    VITO_AP_CHECK(parsed_get_info.Value().app_id.empty() && parsed_get_info.Value().ctx_id.empty());
+  }
+
+  const auto parsed_get_default = ParseRequest(Serialize(Request{ServiceId::kGetDefaultLogLevel}));
+  VITO_AP_CHECK(parsed_get_default && parsed_get_default.Value().service == ServiceId::kGetDefaultLogLevel);
+
+  const auto parsed_set_default =
+      ParseRequest(Serialize(Request{ServiceId::kSetDefaultLogLevel, {}, {}, LogLevel::kVerbose}));
+  VITO_AP_CHECK(parsed_set_default && parsed_set_default.Value().service == ServiceId::kSetDefaultLogLevel);
+  VITO_AP_CHECK(parsed_set_default && parsed_set_default.Value().log_level == LogLevel::kVerbose);
+
+  // an unknown service is passed on, to be answered as not supported
+  const auto parsed_unknown = ParseRequest(Serialize(Request{ServiceId{0x99}}));
+  VITO_AP_CHECK(parsed_unknown && parsed_unknown.Value().service == ServiceId{0x99});
+}
+
+void TestResponseRoundTrip() {
+  Response default_level{ServiceId::kGetDefaultLogLevel};
+  default_level.log_level = LogLevel::kWarn;
+  const auto parsed_default_level = ParseResponse(Serialize(default_level));
+  VITO_AP_CHECK(parsed_default_level.HasValue());
+  if (parsed_default_level) {
+    VITO_AP_CHECK(parsed_default_level.Value().status == Status::kOk);
+    VITO_AP_CHECK(parsed_default_level.Value().log_level == LogLevel::kWarn);
+  }
+
+  Response log_info{ServiceId::kGetLogInfo};
+  log_info.app_id = "APP1";
+  log_info.contexts = {{"CTX1", LogLevel::kInfo, "first context"}, {"CTX2", LogLevel::kOff, ""}};
+  const auto parsed_log_info = ParseResponse(Serialize(log_info));
+  VITO_AP_CHECK(parsed_log_info.HasValue());
+  if (parsed_log_info) {
+    const auto& contexts = parsed_log_info.Value().contexts;
+    VITO_AP_CHECK(parsed_log_info.Value().app_id == "APP1");
+    VITO_AP_CHECK(contexts.size() == 2);
+    if (contexts.size() == 2) {
+      VITO_AP_CHECK(contexts[0].ctx_id == "CTX1" && contexts[0].log_level == LogLevel::kInfo &&
+                    contexts[0].description == "first context");
+      VITO_AP_CHECK(contexts[1].ctx_id == "CTX2" && contexts[1].log_level == LogLevel::kOff &&
+                    contexts[1].description.empty());
+    }
+  }
+
+  // a failed request carries the status only
+  const auto parsed_error = ParseResponse(Serialize(Response{ServiceId::kSetLogLevel, Status::kError}));
+  VITO_AP_CHECK(parsed_error && parsed_error.Value().status == Status::kError);
+
+  // more contexts than fit in one message: as many as fit are listed
+  Response many{ServiceId::kGetLogInfo};
+  many.app_id = "APP1";
+  many.contexts.assign(2000, ContextInfo{"CTX1", LogLevel::kInfo, core::String(40, 'd')});
+  const auto serialized_many = Serialize(many);
+  VITO_AP_CHECK(serialized_many.size() <= kMaxMessageSize);
+  const auto parsed_many = ParseResponse(serialized_many);
+  VITO_AP_CHECK(parsed_many.HasValue());
+  if (parsed_many) {
+    VITO_AP_CHECK(parsed_many.Value().contexts.size() > 1000 && parsed_many.Value().contexts.size() < 2000);
+  }
+}
+
+void TestMalformed() {
+  const auto request = Serialize(Request{ServiceId::kSetLogLevel, "APP1", "CTX1", LogLevel::kDebug});
+
+  // every truncation, with LEN left as it was or made to match the bytes that are left
+  for (std::size_t size{0}; size < request.size(); ++size) {
+    const core::Vector<core::Byte> truncated(request.begin(), request.begin() + static_cast<std::ptrdiff_t>(size));
+    VITO_AP_CHECK(!ParseRequest(truncated));
+    if (size > kLengthOffset + 1) {
+      VITO_AP_CHECK(!ParseRequest(WithLength(truncated, size)));
+    }
+  }
+
+  // LEN not matching the size of the message
+  VITO_AP_CHECK(!ParseRequest(WithLength(request, request.size() + 1)));
+  VITO_AP_CHECK(!ParseRequest(WithLength(request, request.size() - 1)));
+
+  // a string length running past the end of the message: that of the context id, in front of "CTX1\0" and the level
+  auto long_string = request;
+  long_string[long_string.size() - 1 - 5 - 1] = core::Byte{0xFF};
+  VITO_AP_CHECK(!ParseRequest(long_string));
+
+  // levels beyond kVerbose
+  auto bad_level = request;
+  bad_level.back() = core::Byte{static_cast<std::uint8_t>(LogLevel::kVerbose) + 1};
+  VITO_AP_CHECK(!ParseRequest(bad_level));
+  auto bad_default_level = Serialize(Request{ServiceId::kSetDefaultLogLevel, {}, {}, LogLevel::kInfo});
+  bad_default_level.back() = core::Byte{0xFF};
+  VITO_AP_CHECK(!ParseRequest(bad_default_level));
+  Response default_level{ServiceId::kGetDefaultLogLevel};
+  auto bad_response_level = Serialize(default_level);
+  bad_response_level.back() = core::Byte{0x08};
+  VITO_AP_CHECK(!ParseResponse(bad_response_level));
+
+  // a request is no response, and the other way around
+  VITO_AP_CHECK(!ParseResponse(request));
+  VITO_AP_CHECK(!ParseRequest(Serialize(default_level)));
+
+  // not a control message
+  auto not_control = request;
+  not_control[3] = core::Byte{0x4C};
+  VITO_AP_CHECK(!ParseRequest(not_control));
+}
+}  // namespace
+
+int main() {
+  TestRequestRoundTrip();
+  TestResponseRoundTrip();
+  TestMalformed();
+  return ara::test::Result();
+}
@@ -0,0 +1,180 @@
+#include "ara/log/control_server.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "ara/log/context_registry.h"
+#include "ara/log/control_protocol.h"
+#include "ara/log/log_config.h"
+#include "ara/log/log_error_domain.h"
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+using control::Request;
+using control::ServiceId;
+using control::Status;
+
+constexpr const char* kSocketPath{"control.sock"};
+
+int Connect() {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, kSocketPath);
+  const int fd{::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0)};
+  if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/// @brief Send a packet on a connection and return the response to it.
+core::Result<control::Response> Exchange(int fd, const core::Vector<core::Byte>& packet) {
+  core::Vector<core::Byte> response(control::kMaxMessageSize);
+  ssize_t size{-1};
+  if (::send(fd, packet.data(), packet.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(packet.size())) {
+    size = ::recv(fd, response.data(), response.size(), 0);
+  }
+  if (size <= 0) {
+    return core::Result<control::Response>::FromError(LogErrc::kOpenControlChannelFailed);
+  }
+  return control::ParseResponse({response.data(), static_cast<std::size_t>(size)});
+}
+
+Status StatusOf(const core::Result<control::Response>& response) {
+  return response ? response.Value().status : Status{0xFF};
+}
+
+LogLevel ThresholdOf(ContextRegistry& contexts, Logger& logger) {
+  return contexts.Info(logger.GetContextHandle())->threshold;
+}
+
+/// @brief Run logctl on the control socket.
+/// @return its exit status
+int Logctl(const std::string& arguments) {
+  const auto status = std::system((std::string{VITO_AP_LOGCTL} + " " + kSocketPath + " " + arguments).c_str());
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+void TestServe(ContextRegistry& contexts) {
+  auto& first = contexts.GetOrCreate("CTX1", "first context", LogLevel::kInfo);
+  auto& second = contexts.GetOrCreate("CTX2", "second context", LogLevel::kInfo);
+
+  ControlConfig config;
+  config.enabled = true;
+  config.path = kSocketPath;
+  auto opened = ControlServer::Open(config, contexts);
+  VITO_AP_CHECK(opened.HasValue());
+  if (!opened) {
+    return;
+  }
+  auto server = std::move(opened).Value();
+  const int fd{Connect()};
+  VITO_AP_CHECK(fd >= 0);
+  if (fd < 0) {
+    return;
+  }
+
+  // a context of its own, and read back
+  VITO_AP_CHECK(StatusOf(Exchange(fd, control::Serialize(Request{ServiceId::kSetLogLevel, "TEST", "CTX1",
+                                                                 LogLevel::kDebug}))) == Status::kOk);
+  VITO_AP_CHECK(ThresholdOf(contexts, first) == LogLevel::kDebug);
+  VITO_AP_CHECK(first.IsEnabled(LogLevel::kDebug) && !second.IsEnabled(LogLevel::kDebug));
+  const auto info = Exchange(fd, control::Serialize(Request{ServiceId::kGetLogInfo, "", "CTX1"}));
+  VITO_AP_CHECK(StatusOf(info) == Status::kOk);
+  if (info) {
+    VITO_AP_CHECK(info.Value().app_id == "TEST");
+    VITO_AP_CHECK(info.Value().contexts.size() == 1);
+    if (info.Value().contexts.size() == 1) {
+      VITO_AP_CHECK(info.Value().contexts[0].ctx_id == "CTX1");
+      VITO_AP_CHECK(info.Value().contexts[0].log_level == LogLevel::kDebug);
+      VITO_AP_CHECK(info.Value().contexts[0].description == "first context");
+    }
+  }
+
+  // another application or an unknown context is an error, and changes nothing
+  VITO_AP_CHECK(StatusOf(Exchange(fd, control::Serialize(Request{ServiceId::kSetLogLevel, "APP2", "CTX1",
+                                                                 LogLevel::kOff}))) == Status::kError);
+  VITO_AP_CHECK(StatusOf(Exchange(fd, control::Serialize(Request{ServiceId::kSetLogLevel, "", "NONE",
+                                                                 LogLevel::kOff}))) == Status::kError);
+  VITO_AP_CHECK(ThresholdOf(contexts, first) == LogLevel::kDebug);
+
+  // the default applies to the contexts without a level of their own
+  VITO_AP_CHECK(StatusOf(Exchange(fd, control::Serialize(Request{ServiceId::kSetDefaultLogLevel, {}, {},
+                                                                 LogLevel::kWarn}))) == Status::kOk);
+  const auto default_level = Exchange(fd, control::Serialize(Request{ServiceId::kGetDefaultLogLevel}));
+  VITO_AP_CHECK(default_level && default_level.Value().log_level == LogLevel::kWarn);
+  VITO_AP_CHECK(ThresholdOf(contexts, first) == LogLevel::kDebug);
+  VITO_AP_CHECK(ThresholdOf(contexts, second) == LogLevel::kWarn);
+
+  // a malformed request and an unknown service are answered, and the connection stays usable
+  const core::Vector<core::Byte> garbage{core::Byte{1}, core::Byte{2}, core::Byte{3}};
+  VITO_AP_CHECK(StatusOf(Exchange(fd, garbage)) == Status::kError);
+  VITO_AP_CHECK(StatusOf(Exchange(fd, control::Serialize(Request{ServiceId{0x99}}))) == Status::kNotSupported);
+  VITO_AP_CHECK(StatusOf(Exchange(fd, control::Serialize(Request{ServiceId::kGetDefaultLogLevel}))) == Status::kOk);
+  ::close(fd);
+
+  // the same through logctl
+  VITO_AP_CHECK(Logctl("set-level CTX2 VERBOSE") == 0);
+  VITO_AP_CHECK(ThresholdOf(contexts, second) == LogLevel::kVerbose);
+  VITO_AP_CHECK(Logctl("get-contexts > contexts.txt") == 0);
+  std::ifstream listed{"contexts.txt"};
+  const std::string listing{std::istreambuf_iterator<char>{listed}, {}};
+  VITO_AP_CHECK(listing.find("CTX2 VERBOSE second context") != std::string::npos);
+  VITO_AP_CHECK(Logctl("set-level NONE INFO 2> /dev/null") != 0);
+  VITO_AP_CHECK(Logctl("set-level CTX2 LOUD 2> /dev/null") != 0);
+
+  // closing the server removes the socket
+  server.reset();
+  VITO_AP_CHECK(::access(kSocketPath, F_OK) != 0);
+}
+
+void TestSocketPath(ContextRegistry& contexts) {
+  ControlConfig config;
+  config.enabled = true;
+  config.path = kSocketPath;
+
+  // a socket left behind by an earlier run is replaced
+  const int stale{::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0)};
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, kSocketPath);
+  VITO_AP_CHECK(::bind(stale, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+  ::close(stale);
+  auto replacing = ControlServer::Open(config, contexts);
+  VITO_AP_CHECK(replacing.HasValue());
+  auto server = replacing ? std::move(replacing).Value() : nullptr;
+
+  // that of a running instance is not
+  VITO_AP_CHECK(!ControlServer::Open(config, contexts).HasValue());
+  VITO_AP_CHECK(::access(kSocketPath, F_OK) == 0);
+  server.reset();
+
+  // nor is anything else
+  std::ofstream{kSocketPath} << "not a socket";
+  VITO_AP_CHECK(!ControlServer::Open(config, contexts).HasValue());
+  VITO_AP_CHECK(::unlink(kSocketPath) == 0);
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["CONSOLE"], "AppId": "TEST"})");
+  VITO_AP_CHECK(LogConfig::Instance().Init("MANIFEST.json").HasValue());
+  ::unlink(kSocketPath);
+
+  ContextRegistry contexts;
+  contexts.SetRoutes({}, 1);
+  TestServe(contexts);
+  TestSocketPath(contexts);
+  return ara::test::Result();
+}
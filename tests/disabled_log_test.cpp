@@ -0,0 +1,58 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "ara/core/initialization.h"
+#include "ara/log/logger.h"
+#include "test_util.h"
+
+namespace {
+/// @brief number of heap allocations of the calling thread, counted by the replaced operator new
+thread_local std::size_t allocations{0};
+
+struct Sample : ara::log::ModeledMessage<0x10, ara::log::LogLevel::kDebug, std::uint32_t, double> {
+  static constexpr ara::core::StringView kFormat{"sample {} value {}"};
+  static constexpr std::array<ara::log::ArgumentInfo, 2> kArguments{{{"sample", ""}, {"value", ""}}};
+};
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "TEST"})");
+  VITO_AP_CHECK(ara::core::Initialize().HasValue());
+
+  auto& logger = ara::log::CreateLogger("DIS", "disabled levels", ara::log::LogLevel::kInfo);
+  const ara::core::String text{"a string long enough not to fit the small string buffer"};
+  // one enabled message, so that the allocations of the first use of the thread are not counted
+  logger.LogInfo() << "warm up";
+  VITO_AP_CHECK(!logger.IsEnabled(ara::log::LogLevel::kDebug));
+
+  const auto before = allocations;
+  for (std::uint32_t i{0}; i < 1000; ++i) {
+    logger.LogDebug() << "value" << i << 0.5 << text;
+    logger.LogVerbose() << text << ara::log::Arg(i, "index", nullptr, ara::log::Hex());
+    logger.WithLevel(ara::log::LogLevel::kDebug) << "dynamic level" << i;
+    logger.LogLazy(ara::log::LogLevel::kDebug, [&text](ara::log::LogStream& stream) { stream << text; });
+    logger.Log(Sample{}, i, 0.5);
+  }
+  VITO_AP_CHECK(allocations == before);
+
+  // the replaced operator new must see allocations, such as this copy of a long string, or the check above proves
+  // nothing
+  logger.LogInfo() << ara::core::String{text};
+  VITO_AP_CHECK(allocations > before);
+
+  VITO_AP_CHECK(ara::core::Deinitialize().HasValue());
+  return ara::test::Result();
+}
@@ -0,0 +1,312 @@
+#include <array>
+#include <chrono>
+#include <cstring>
+
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_config.h"
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+
+constexpr std::uint32_t kVersion{2U << 5};
+constexpr std::uint32_t kWeid{1U << 2};
+constexpr std::uint32_t kWacid{1U << 3};
+constexpr std::uint32_t kWsfln{1U << 8};
+constexpr std::uint32_t kWtgs{1U << 9};
+constexpr std::uint32_t kVari{1U << dlt::Payload::kTypeVariableInfoOffset};
+
+/// @brief Reader of the little endian payload, the counterpart of Payload: it decodes the bytes independently of it.
+class PayloadReader {
+ public:
+  explicit PayloadReader(core::Span<const core::Byte> in) : in_{in} {}
+
+  template <typename T>
+  T Read() {
+    T value{};
+    VITO_AP_CHECK(offset_ + sizeof value <= in_.size());
+    if (offset_ + sizeof value <= in_.size()) {
+      std::memcpy(&value, in_.data() + offset_, sizeof value);
+      offset_ += sizeof value;
+    }
+    return dlt::LittleEndian(value);
+  }
+
+  core::StringView ReadText(std::size_t length) {
+    VITO_AP_CHECK(length > 0 && offset_ + length <= in_.size());
+    if (length == 0 || offset_ + length > in_.size()) {
+      return {};
+    }
+    const core::StringView text{reinterpret_cast<const char*>(in_.data() + offset_), length - 1};
+    VITO_AP_CHECK(in_[offset_ + length - 1] == core::Byte{0});
+    offset_ += length;
+    return text;
+  }
+
+  bool AtEnd() const { return offset_ == in_.size(); }
+
+ private:
+  core::Span<const core::Byte> in_;
+  std::size_t offset_{0};
+};
+
+/// @brief The base header fields common to verbose and non-verbose messages.
+struct Header {
+  std::uint32_t htyp2;
+  std::uint8_t mcnt;
+  std::uint16_t len;
+};
+
+Header ReadHeader(dlt::ByteReader& reader) {
+  return Header{reader.Read<std::uint32_t>().value_or(0), reader.Read<std::uint8_t>().value_or(0),
+                reader.Read<std::uint16_t>().value_or(0)};
+}
+
+/// @brief Read TMSP2 and check it against the wall-clock time around the creation of the message.
+void CheckTimestamp(dlt::ByteReader& reader, std::uint64_t before, std::uint64_t after) {
+  const auto nanoseconds = reader.Read<std::uint32_t>().value_or(UINT32_MAX);
+  const std::uint64_t seconds_high{reader.Read<std::uint8_t>().value_or(0)};
+  const std::uint64_t seconds{seconds_high << 32 | reader.Read<std::uint32_t>().value_or(0)};
+  VITO_AP_CHECK(nanoseconds < 1'000'000'000U);
+  VITO_AP_CHECK(seconds >= before && seconds <= after);
+}
+
+std::uint64_t NowSeconds() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+core::Span<const core::Byte> PayloadOf(core::Span<const core::Byte> bytes, std::size_t header_size) {
+  return bytes.subspan(header_size);
+}
+
+void TestVerboseHeader() {
+  const auto before = NowSeconds();
+  auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kWarn, "CTX1");
+  auto next = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "CTX1");
+  const auto after = NowSeconds();
+  VITO_AP_CHECK(message->AddArgument(std::uint32_t{1}).HasValue());
+  VITO_AP_CHECK(message->AddArgument(true).HasValue());
+
+  std::array<core::Byte, 256> out{};
+  const auto size = message->SerializeTo(out);
+  VITO_AP_CHECK(size.HasValue());
+  if (!size) {
+    return;
+  }
+  VITO_AP_CHECK(*size == message->SerializedSize());
+
+  dlt::ByteReader reader{core::Span<const core::Byte>{out.data(), *size}};
+  const auto header = ReadHeader(reader);
+  VITO_AP_CHECK(header.htyp2 == (kVersion | kWeid | kWacid));
+  VITO_AP_CHECK(header.len == *size);
+  // MSTP log (0) in bits 1..3, MTIN warn (3) in bits 4..7
+  VITO_AP_CHECK(reader.Read<std::uint8_t>() == std::uint8_t{0x30});
+  VITO_AP_CHECK(reader.Read<std::uint8_t>() == std::uint8_t{2});
+  CheckTimestamp(reader, before, after);
+  VITO_AP_CHECK(reader.ReadString() == core::StringView{"ECU1"});
+  VITO_AP_CHECK(reader.ReadString() == core::StringView{"TEST"});
+  VITO_AP_CHECK(reader.ReadString() == core::StringView{"CTX1"});
+
+  // header fields are big endian, so the low byte of HTYP2 and LEN come last
+  VITO_AP_CHECK(out[0] == core::Byte{0} && out[3] == core::Byte{kVersion | kWeid | kWacid});
+  VITO_AP_CHECK((std::to_integer<std::size_t>(out[5]) << 8 | std::to_integer<std::size_t>(out[6])) == *size);
+
+  std::array<core::Byte, 256> next_out{};
+  VITO_AP_CHECK(next->SerializeTo(next_out).HasValue());
+  VITO_AP_CHECK(next_out[4] == core::Byte{static_cast<std::uint8_t>(header.mcnt + 1)});
+}
+
+void TestSourceLocationAndTags() {
+  auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kError, "CTX2");
+  message->SetSourceLocation("main.cpp", 42);
+  message->AddTag("net");
+  message->AddTag("io");
+
+  std::array<core::Byte, 256> out{};
+  const auto size = message->SerializeTo(out);
+  VITO_AP_CHECK(size.HasValue() && *size == message->SerializedSize());
+  if (!size) {
+    return;
+  }
+
+  dlt::ByteReader reader{core::Span<const core::Byte>{out.data(), *size}};
+  const auto header = ReadHeader(reader);
+  VITO_AP_CHECK(header.htyp2 == (kVersion | kWeid | kWacid | kWsfln | kWtgs));
+  VITO_AP_CHECK(reader.Read<std::uint8_t>() == std::uint8_t{0x20});
+  VITO_AP_CHECK(reader.Read<std::uint8_t>() == std::uint8_t{0});
+  CheckTimestamp(reader, 0, UINT64_MAX);
+  VITO_AP_CHECK(reader.ReadString() == core::StringView{"ECU1"});
+  VITO_AP_CHECK(reader.ReadString() == core::StringView{"TEST"});
+  VITO_AP_CHECK(reader.ReadString() == core::StringView{"CTX2"});
+  VITO_AP_CHECK(reader.ReadString() == core::StringView{"main.cpp"});
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == std::uint32_t{42});
+  VITO_AP_CHECK(reader.Read<std::uint8_t>() == std::uint8_t{2});
+  VITO_AP_CHECK(reader.ReadString() == core::StringView{"net"});
+  VITO_AP_CHECK(reader.ReadString() == core::StringView{"io"});
+  VITO_AP_CHECK(!reader.Read<std::uint8_t>());
+}
+
+void TestVerboseArguments() {
+  auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "CTX1");
+  const std::array<core::Byte, 3> raw{core::Byte{0xDE}, core::Byte{0xAD}, core::Byte{0x01}};
+  VITO_AP_CHECK(message->AddArgument(true).HasValue());
+  VITO_AP_CHECK(message->AddArgument(std::int16_t{-2}).HasValue());
+  VITO_AP_CHECK(message->AddArgument(std::uint32_t{0x1122'3344}).HasValue());
+  VITO_AP_CHECK(message->AddArgument(std::int64_t{-5'000'000'000}).HasValue());
+  VITO_AP_CHECK(message->AddArgument(0.5).HasValue());
+  VITO_AP_CHECK(message->AddArgument(core::StringView{"hello"}).HasValue());
+  VITO_AP_CHECK(message->AddArgument(core::Span<const core::Byte>{raw}).HasValue());
+
+  std::array<core::Byte, 256> out{};
+  const auto size = message->SerializeTo(out);
+  VITO_AP_CHECK(size.HasValue());
+  if (!size) {
+    return;
+  }
+  // base header with TMSP2, then ECU, APP and CTX ids of 4 characters
+  constexpr std::size_t kHeaderSize{4 + 1 + 2 + 1 + 1 + 9 + 3 * 6};
+  VITO_AP_CHECK(std::to_integer<std::uint8_t>(out[8]) == 7);
+
+  const auto payload = PayloadOf(core::Span<const core::Byte>{out.data(), *size}, kHeaderSize);
+  // verbose payloads are little endian: the low byte of the value comes first
+  const std::array<core::Byte, 8> expected{core::Byte{0x43}, core::Byte{0x00}, core::Byte{0x00}, core::Byte{0x00},
+                                           core::Byte{0x44}, core::Byte{0x33}, core::Byte{0x22}, core::Byte{0x11}};
+  VITO_AP_CHECK(std::equal(expected.begin(), expected.end(), payload.begin() + 11));
+
+  PayloadReader reader{payload};
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == (1U | 1U << dlt::Payload::kTypeBoolOffset));
+  VITO_AP_CHECK(reader.Read<std::uint8_t>() == 1);
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == (2U | 1U << dlt::Payload::kTypeSignedOffset));
+  VITO_AP_CHECK(reader.Read<std::int16_t>() == -2);
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == (3U | 1U << dlt::Payload::kTypeUnsignedOffset));
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == 0x1122'3344U);
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == (4U | 1U << dlt::Payload::kTypeSignedOffset));
+  VITO_AP_CHECK(reader.Read<std::int64_t>() == -5'000'000'000);
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == (4U | 1U << dlt::Payload::kTypeFloatOffset));
+  VITO_AP_CHECK(reader.Read<double>() == 0.5);
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() ==
+                (1U << dlt::Payload::kTypeStringOffset |
+                 dlt::Payload::kStringCodingUtf8 << dlt::Payload::kStringCodingOffset));
+  VITO_AP_CHECK(reader.ReadText(reader.Read<std::uint16_t>()) == core::StringView{"hello"});
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == 1U << dlt::Payload::kTypeRawOffset);
+  VITO_AP_CHECK(reader.Read<std::uint16_t>() == raw.size());
+  VITO_AP_CHECK(reader.Read<std::uint8_t>() == 0xDE && reader.Read<std::uint8_t>() == 0xAD &&
+                reader.Read<std::uint8_t>() == 0x01);
+  VITO_AP_CHECK(reader.AtEnd());
+}
+
+void TestAttributedArguments() {
+  auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "CTX1");
+  VITO_AP_CHECK(message->AddArgument(std::uint16_t{0xBEEF}, ArgumentAttributes{"speed", "km/h", {Fmt::kHex, 4}})
+                    .HasValue());
+  VITO_AP_CHECK(message->AddArgument(core::StringView{"up"}, ArgumentAttributes{"state", nullptr, {Fmt::kDefault, 0}})
+                    .HasValue());
+
+  std::array<core::Byte, 256> out{};
+  const auto size = message->SerializeTo(out);
+  VITO_AP_CHECK(size.HasValue());
+  if (!size) {
+    return;
+  }
+  constexpr std::size_t kHeaderSize{4 + 1 + 2 + 1 + 1 + 9 + 3 * 6};
+  PayloadReader reader{PayloadOf(core::Span<const core::Byte>{out.data(), *size}, kHeaderSize)};
+
+  // numeric arguments: type info, name and unit lengths, name, unit and value
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == (2U | 1U << dlt::Payload::kTypeUnsignedOffset | kVari |
+                                                 dlt::Payload::kStringCodingHex << dlt::Payload::kStringCodingOffset));
+  const auto name_length = reader.Read<std::uint16_t>();
+  const auto unit_length = reader.Read<std::uint16_t>();
+  VITO_AP_CHECK(reader.ReadText(name_length) == core::StringView{"speed"});
+  VITO_AP_CHECK(reader.ReadText(unit_length) == core::StringView{"km/h"});
+  VITO_AP_CHECK(reader.Read<std::uint16_t>() == 0xBEEF);
+
+  // strings: type info, value and name lengths, name and value; DLT has no unit for them
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() ==
+                (1U << dlt::Payload::kTypeStringOffset | kVari |
+                 dlt::Payload::kStringCodingUtf8 << dlt::Payload::kStringCodingOffset));
+  const auto value_length = reader.Read<std::uint16_t>();
+  const auto string_name_length = reader.Read<std::uint16_t>();
+  VITO_AP_CHECK(reader.ReadText(string_name_length) == core::StringView{"state"});
+  VITO_AP_CHECK(reader.ReadText(value_length) == core::StringView{"up"});
+  VITO_AP_CHECK(reader.AtEnd());
+}
+
+struct Sample : ModeledMessage<0x1234, LogLevel::kDebug, std::uint32_t, std::int8_t, core::StringView> {
+  static constexpr core::StringView kFormat{"sample {} offset {} name {}"};
+  static constexpr std::array<ArgumentInfo, 3> kArguments{{{"sample", ""}, {"offset", ""}, {"name", ""}}};
+};
+
+void TestNonVerbose() {
+  const auto before = NowSeconds();
+  auto message = dlt::Message::NonVerboseModeLogMessage(detail::kModeledMessageInfo<Sample>, "CTX1");
+  const auto after = NowSeconds();
+  const std::uint32_t sample{0xA0B0'C0D0};
+  const std::int8_t offset{-1};
+  const core::StringView name{"abc"};
+  VITO_AP_CHECK(message->AddModeledArgument(ArgumentType::kUint32, std::as_bytes(core::Span<const std::uint32_t, 1>{
+                                                                         &sample, 1}))
+                    .HasValue());
+  VITO_AP_CHECK(
+      message->AddModeledArgument(ArgumentType::kInt8, std::as_bytes(core::Span<const std::int8_t, 1>{&offset, 1}))
+          .HasValue());
+  VITO_AP_CHECK(
+      message->AddModeledArgument(ArgumentType::kString, std::as_bytes(core::Span<const char>{name.data(), name.size()}))
+          .HasValue());
+
+  std::array<core::Byte, 256> out{};
+  const auto size = message->SerializeTo(out);
+  VITO_AP_CHECK(size.HasValue());
+  if (!size) {
+    return;
+  }
+  VITO_AP_CHECK(*size == message->SerializedSize());
+
+  // no extension header: the message id alone identifies the message, its context and level
+  dlt::ByteReader reader{core::Span<const core::Byte>{out.data(), *size}};
+  const auto header = ReadHeader(reader);
+  VITO_AP_CHECK(header.htyp2 == (kVersion | 0x1U));
+  VITO_AP_CHECK(header.len == *size);
+  CheckTimestamp(reader, before, after);
+  VITO_AP_CHECK(reader.Read<std::uint32_t>() == std::uint32_t{0x1234});
+
+  // the values alone, little endian, with strings behind their 16 bit length
+  constexpr std::size_t kHeaderSize{4 + 1 + 2 + 9 + 4};
+  PayloadReader payload{PayloadOf(core::Span<const core::Byte>{out.data(), *size}, kHeaderSize)};
+  VITO_AP_CHECK(payload.Read<std::uint32_t>() == sample);
+  VITO_AP_CHECK(payload.Read<std::int8_t>() == offset);
+  VITO_AP_CHECK(payload.ReadText(payload.Read<std::uint16_t>()) == name);
+  VITO_AP_CHECK(payload.AtEnd());
+}
+
+void TestOverflow() {
+  auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "CTX1");
+  VITO_AP_CHECK(message->AddArgument(std::uint32_t{7}).HasValue());
+
+  std::array<core::Byte, 16> small{};
+  const auto result = message->SerializeTo(small);
+  VITO_AP_CHECK(!result.HasValue() && result.Error() == LogErrc::kBufferOverflow);
+
+  // a string longer than the 16 bit length field is rejected, not wrapped, and later arguments are dropped
+  const core::String huge(70'000, 'x');
+  const auto size = message->SerializedSize();
+  VITO_AP_CHECK(!message->AddArgument(core::StringView{huge}).HasValue());
+  VITO_AP_CHECK(!message->AddArgument(std::uint8_t{1}).HasValue());
+  VITO_AP_CHECK(message->SerializedSize() == size);
+  VITO_AP_CHECK(message->GetPayload().NumberOfArguments() == 1);
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["CONSOLE"], "AppId": "TEST"})");
+  VITO_AP_CHECK(ara::log::LogConfig::Instance().Init("MANIFEST.json").HasValue());
+
+  TestVerboseHeader();
+  TestSourceLocationAndTags();
+  TestVerboseArguments();
+  TestAttributedArguments();
+  TestNonVerbose();
+  TestOverflow();
+  return ara::test::Result();
+}
@@ -0,0 +1,139 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+#include "ara/log/dlt_message.h"
+#include "ara/log/flight_recorder.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logging_handler.h"
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+
+constexpr const char* kPath{"ring.fdr"};
+/// @brief a few hundred records
+constexpr std::size_t kRingSize{1 << 14};
+
+std::shared_ptr<dlt::Message> IndexedMessage(std::uint32_t index) {
+  auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "FDR");
+  (void)message->AddArgument(core::StringView{"flight recorder test message"});
+  (void)message->AddArgument(index);
+  return message;
+}
+
+void Write(std::uint32_t first, std::uint32_t last) {
+  FlightRecorderConfig config;
+  config.path = kPath;
+  config.size = kRingSize;
+  auto handler = FlightRecorderHandler::Open(config);
+  VITO_AP_CHECK(handler.HasValue());
+  if (!handler) {
+    return;
+  }
+  for (auto index = first; index <= last; ++index) {
+    (*handler)->Emit(IndexedMessage(index));
+  }
+}
+
+/// @brief Read the ring back and return the index each message carries as its last argument.
+/// @return nullopt if the file cannot be read
+core::Optional<std::vector<std::uint32_t>> ReadIndices() {
+  std::vector<std::uint32_t> indices;
+  const auto read = flight_recorder::Read(kPath, [&indices](core::Span<const core::Byte> message) {
+    std::uint32_t index;
+    std::memcpy(&index, message.data() + message.size() - sizeof index, sizeof index);
+    indices.push_back(dlt::LittleEndian(index));
+  });
+  if (!read) {
+    return std::nullopt;
+  }
+  return indices;
+}
+
+/// @brief Check that indices are consecutive and end with last.
+bool Consecutive(const std::vector<std::uint32_t>& indices, std::uint32_t last) {
+  for (std::size_t i{0}; i < indices.size(); ++i) {
+    if (indices[i] != last - (indices.size() - 1 - i)) {
+      return false;
+    }
+  }
+  return !indices.empty();
+}
+
+/// @brief Reserve a record the way FlightRecorderHandler::Emit() does and write part of it, as a writer that died
+/// before finishing it leaves it behind.
+/// @param fraction the part of the message written, in percent
+void WriteTornRecord(const dlt::Message& message, std::size_t fraction) {
+  using flight_recorder::RecordHeader;
+
+  const int fd{::open(kPath, O_RDWR | O_CLOEXEC)};
+  const auto mapping_size = flight_recorder::kDataOffset + kRingSize;
+  auto* const mapping =
+      static_cast<core::Byte*>(::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+  ::close(fd);
+  VITO_AP_CHECK(mapping != MAP_FAILED);
+  if (mapping == MAP_FAILED) {
+    return;
+  }
+
+  auto& header = *reinterpret_cast<flight_recorder::FileHeader*>(mapping);
+  const auto bytes = message.Serialized();
+  const auto record_size = flight_recorder::RecordSize(bytes.size());
+  const auto head = header.head.load();
+  const auto offset = head % kRingSize;
+  const auto position = offset + record_size > kRingSize ? head + (kRingSize - offset) : head;
+  header.head = position + record_size;
+
+  auto* const data = mapping + flight_recorder::kDataOffset + position % kRingSize;
+  auto* const record = reinterpret_cast<RecordHeader*>(data);
+  record->magic = 0;
+  record->size = static_cast<std::uint32_t>(bytes.size());
+  record->position = position;
+  std::memcpy(data + sizeof(RecordHeader), bytes.data(), bytes.size() * fraction / 100);
+  ::munmap(mapping, mapping_size);
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FLIGHT_RECORDER"], "AppId": "TEST"})");
+  VITO_AP_CHECK(LogConfig::Instance().Init("MANIFEST.json").HasValue());
+  ::unlink(kPath);
+
+  // no file, an empty file, and a new ring without records
+  VITO_AP_CHECK(!ReadIndices());
+  ::close(::open(kPath, O_WRONLY | O_CREAT | O_CLOEXEC, 0644));
+  VITO_AP_CHECK(!ReadIndices());
+  Write(1, 0);
+  const auto empty = ReadIndices();
+  VITO_AP_CHECK(empty && empty->empty());
+
+  // several times around the ring: the newest records survive, oldest first
+  const auto record_size = flight_recorder::RecordSize(IndexedMessage(0)->Serialized().size());
+  const auto ring_records = static_cast<std::uint32_t>(kRingSize / record_size);
+  Write(0, 5 * ring_records);
+  const auto wrapped = ReadIndices();
+  VITO_AP_CHECK(wrapped && Consecutive(*wrapped, 5 * ring_records));
+  // all of the ring but the tail too short for a record, and the record the next one would replace
+  VITO_AP_CHECK(wrapped && wrapped->size() + 1 >= ring_records);
+
+  // a record of two and a half ordinary ones, 60% written: it invalidated the oldest record and wrote over the header
+  // of the one after, so both are gone, and it is not complete itself
+  auto torn = IndexedMessage(0);
+  (void)torn->AddArgument(core::StringView{core::String(record_size * 3 / 2, 'x')});
+  WriteTornRecord(*torn, 60);
+  const auto after_torn = ReadIndices();
+  VITO_AP_CHECK(wrapped && after_torn && after_torn->size() == wrapped->size() - 2);
+  VITO_AP_CHECK(after_torn && Consecutive(*after_torn, 5 * ring_records));
+
+  // reopened, the ring is continued after the torn record
+  Write(5 * ring_records + 1, 5 * ring_records + 10);
+  const auto continued = ReadIndices();
+  VITO_AP_CHECK(continued && Consecutive(*continued, 5 * ring_records + 10));
+  VITO_AP_CHECK(continued && continued->size() + 1 >= ring_records - 3);
+  return ara::test::Result();
+}
@@ -0,0 +1,76 @@
+#include <sys/wait.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "ara/core/initialization.h"
+#include "ara/log/logger.h"
+#include "test_util.h"
+
+namespace catalog_test {
+struct ExecutableMessage : ara::log::ModeledMessage<0x100, ara::log::LogLevel::kInfo, std::uint32_t, double> {
+  static constexpr ara::core::StringView kFormat{"executable sample {} speed {}"};
+  static constexpr std::array<ara::log::ArgumentInfo, 2> kArguments{{{"sample", ""}, {"speed", "km/h"}}};
+};
+
+/// @brief Defined in catalog_library.cpp, which is built as a shared library.
+void LogLibraryMessage(ara::log::Logger& logger);
+}  // namespace catalog_test
+
+namespace {
+/// @brief Run a command through the shell.
+/// @return its exit status
+int Run(const std::string& command) {
+  const auto status = std::system(command.c_str());
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/// @brief Export the catalog of binaries to catalog.json.
+/// @return the exit status of log_catalog
+int ExportCatalog(const std::string& binaries) {
+  return Run(std::string{VITO_AP_LOG_CATALOG} + " -o catalog.json " + binaries + " 2> /dev/null");
+}
+
+std::string ReadCatalog() {
+  std::ifstream file{"catalog.json"};
+  return {std::istreambuf_iterator<char>{file}, {}};
+}
+
+bool Contains(const std::string& text, const std::string& part) { return text.find(part) != std::string::npos; }
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "TEST"})");
+  VITO_AP_CHECK(ara::core::Initialize().HasValue());
+  auto& logger = ara::log::CreateLogger("CAT", "catalog test", ara::log::LogLevel::kInfo);
+  logger.Log(catalog_test::ExecutableMessage{}, std::uint32_t{1}, 2.5);
+  catalog_test::LogLibraryMessage(logger);
+  VITO_AP_CHECK(ara::core::Deinitialize().HasValue());
+
+  // the messages of the executable and of the shared library it links go into one catalog
+  const auto executable = std::filesystem::read_symlink("/proc/self/exe").string();
+  const std::string library{VITO_AP_CATALOG_LIBRARY};
+  VITO_AP_CHECK(ExportCatalog(executable + " " + library) == 0);
+  auto catalog = ReadCatalog();
+  VITO_AP_CHECK(Contains(catalog, R"("format": "executable sample {} speed {}")"));
+  VITO_AP_CHECK(Contains(catalog, R"("unit": "km/h")"));
+  VITO_AP_CHECK(Contains(catalog, R"("format": "library sample {}")"));
+
+  // a stripped shared library still exports its entries
+  VITO_AP_CHECK(Run(std::string{VITO_AP_STRIP} + " -o stripped.so " + library) == 0);
+  VITO_AP_CHECK(ExportCatalog("stripped.so") == 0);
+  catalog = ReadCatalog();
+  VITO_AP_CHECK(Contains(catalog, R"("format": "library sample {}")"));
+  VITO_AP_CHECK(!Contains(catalog, "executable sample"));
+
+  // a stripped executable has none left, which is an error rather than an empty catalog
+  VITO_AP_CHECK(Run(std::string{VITO_AP_STRIP} + " -o stripped " + executable) == 0);
+  VITO_AP_CHECK(ExportCatalog("stripped") != 0);
+
+  // not a binary
+  VITO_AP_CHECK(ExportCatalog("MANIFEST.json") != 0);
+  return ara::test::Result();
+}
@@ -0,0 +1,143 @@
+#include "ara/log/log_limit.h"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/core/initialization.h"
+#include "ara/log/logger.h"
+#include "ara/log/logger_manager.h"
+#include "ara/log/logging_handler.h"
+#include "test_util.h"
+
+namespace {
+using namespace std::chrono_literals;
+using ara::log::LogLimit;
+
+/// @brief Take decisions until the first suppressed message, for at most limit of them.
+/// @return the number of messages allowed
+std::uint32_t AllowedInARow(LogLimit& limit, std::uint32_t max = 1000) {
+  std::uint32_t allowed{0};
+  while (allowed < max && limit.Allow()) {
+    ++allowed;
+  }
+  return allowed;
+}
+
+void TestTokenBucket() {
+  // a full bucket lets the burst through at once, then one message per refill interval
+  LogLimit limit{LogLimit::TokenBucket(10, 5)};
+  VITO_AP_CHECK(AllowedInARow(limit) == 5);
+  VITO_AP_CHECK(!limit.Allow());
+  std::this_thread::sleep_for(250ms);
+  const auto refilled = AllowedInARow(limit);
+  VITO_AP_CHECK(refilled >= 1 && refilled <= 3);
+  // after a quiet period no more than the burst
+  std::this_thread::sleep_for(1s);
+  VITO_AP_CHECK(AllowedInARow(limit) == 5);
+
+  // without a burst, one message per interval
+  LogLimit single{LogLimit::TokenBucket(1000)};
+  VITO_AP_CHECK(AllowedInARow(single) == 1);
+
+  // rates without a meaningful interval are raised to the lowest rate: the burst, then nothing for an hour
+  LogLimit zero{LogLimit::TokenBucket(0, 3)};
+  VITO_AP_CHECK(AllowedInARow(zero) == 3);
+  LogLimit negative{LogLimit::TokenBucket(-5, 2)};
+  VITO_AP_CHECK(AllowedInARow(negative) == 2);
+  LogLimit nan{LogLimit::TokenBucket(std::numeric_limits<double>::quiet_NaN(), 2)};
+  VITO_AP_CHECK(AllowedInARow(nan) == 2);
+  LogLimit large_burst{LogLimit::TokenBucket(0, std::numeric_limits<std::uint32_t>::max())};
+  VITO_AP_CHECK(AllowedInARow(large_burst) == 1000);
+
+  // no interval at all: nothing is suppressed
+  LogLimit unlimited{LogLimit::TokenBucket(std::numeric_limits<double>::infinity())};
+  VITO_AP_CHECK(AllowedInARow(unlimited) == 1000);
+}
+
+void TestEveryN() {
+  LogLimit limit{LogLimit::EveryN(3)};
+  std::vector<bool> decisions;
+  for (int i{0}; i < 9; ++i) {
+    decisions.push_back(limit.Allow());
+  }
+  VITO_AP_CHECK((decisions == std::vector<bool>{true, false, false, true, false, false, true, false, false}));
+
+  LogLimit every{LogLimit::EveryN(0)};
+  VITO_AP_CHECK(AllowedInARow(every, 10) == 10);
+}
+
+void TestFirstN() {
+  LogLimit limit{LogLimit::FirstN(2)};
+  VITO_AP_CHECK(AllowedInARow(limit) == 2);
+  for (int i{0}; i < 10; ++i) {
+    VITO_AP_CHECK(!limit.Allow());
+  }
+
+  LogLimit none{LogLimit::FirstN(0)};
+  VITO_AP_CHECK(!none.Allow());
+}
+
+std::vector<std::string> ReadLog() {
+  for (const auto& handler : ara::log::LoggerManager::Instance().GetLoggingHandlers()) {
+    dynamic_cast<ara::log::FileHandler&>(*handler).Flush();
+  }
+  std::vector<std::string> lines;
+  std::ifstream file{"limit.log"};
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+bool Contains(const std::string& line, const std::string& text) { return line.find(text) != std::string::npos; }
+
+void TestSummary() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "TEST",
+                              "File": {"Path": "limit.log"}, "RateLimit": {"SummaryIntervalMs": 200}})");
+  ::unlink("limit.log");
+  VITO_AP_CHECK(ara::core::Initialize().HasValue());
+
+  auto& logger = ara::log::CreateLogger("LIM", "limit test", ara::log::LogLevel::kInfo);
+  static LogLimit limit{LogLimit::FirstN(1)};
+  for (std::uint32_t i{0}; i < 10; ++i) {
+    logger.WithLimit(ara::log::LogLevel::kWarn, limit) << "limited" << i;
+  }
+  // filtered messages do not count as suppressed
+  logger.WithLimit(ara::log::LogLevel::kDebug, limit) << "filtered";
+
+  // the summary of the period, in the context and at the level of the limited statement
+  std::this_thread::sleep_for(500ms);
+  auto lines = ReadLog();
+  VITO_AP_CHECK(lines.size() == 2);
+  if (lines.size() == 2) {
+    VITO_AP_CHECK(Contains(lines[0], "|LIM|") && Contains(lines[0], "|limited 0 "));
+    VITO_AP_CHECK(Contains(lines[1], "|LIM|") && Contains(lines[1], "|WARN|") &&
+                  Contains(lines[1], "rate limit suppressed 9 messages"));
+  }
+
+  // nothing to report in the periods after, until more is suppressed; the rest is reported when stopping
+  std::this_thread::sleep_for(500ms);
+  VITO_AP_CHECK(ReadLog().size() == 2);
+  logger.WithLimit(ara::log::LogLevel::kWarn, limit) << "limited";
+  VITO_AP_CHECK(ara::core::Deinitialize().HasValue());
+  lines = ReadLog();
+  VITO_AP_CHECK(lines.size() == 3);
+  if (lines.size() == 3) {
+    VITO_AP_CHECK(Contains(lines[2], "rate limit suppressed 1 messages"));
+  }
+}
+}  // namespace
+
+int main() {
+  TestTokenBucket();
+  TestEveryN();
+  TestFirstN();
+  TestSummary();
+  return ara::test::Result();
+}
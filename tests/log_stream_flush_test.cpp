@@ -0,0 +1,71 @@
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ara/core/initialization.h"
+#include "ara/log/logger.h"
+#include "ara/log/logger_manager.h"
+#include "ara/log/logging_handler.h"
+#include "test_util.h"
+
+namespace {
+constexpr std::uint32_t kRounds{1000};
+
+std::vector<std::string> ReadLines(const char* path) {
+  std::vector<std::string> lines;
+  std::ifstream file{path};
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+std::string Expected(std::uint32_t round, std::uint32_t part) {
+  return "round " + std::to_string(round) + " part " + std::to_string(part);
+}
+}  // namespace
+
+int main() {
+  // the writer thread renders the messages while the producer goes on with the stream
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "TEST", "Async": {"Enabled": true},
+                              "File": {"Path": "flush.log"}})");
+  ::unlink("flush.log");
+  VITO_AP_CHECK(ara::core::Initialize().HasValue());
+
+  auto& logger = ara::log::CreateLogger("FLSH", "flush test", ara::log::LogLevel::kInfo);
+  for (std::uint32_t round{0}; round < kRounds; ++round) {
+    auto stream = logger.LogInfo();
+    stream << "round" << round << "part" << std::uint32_t{0};
+    stream.Flush();
+    stream << "round" << round << "part" << std::uint32_t{1};
+    stream.Flush();
+    // emitted by the destructor
+    stream << "round" << round << "part" << std::uint32_t{2};
+  }
+  {
+    // nothing appended after the last flush: the destructor emits nothing more
+    auto stream = logger.LogInfo();
+    stream << "round" << kRounds << "part" << std::uint32_t{0};
+    stream.Flush();
+  }
+  // stops the writer thread once it has emitted everything queued; the file buffers are written at exit otherwise
+  VITO_AP_CHECK(ara::core::Deinitialize().HasValue());
+  for (const auto& handler : ara::log::LoggerManager::Instance().GetLoggingHandlers()) {
+    dynamic_cast<ara::log::FileHandler&>(*handler).Flush();
+  }
+
+  // one record per flush, each holding only what was appended since the previous one
+  const auto lines = ReadLines("flush.log");
+  VITO_AP_CHECK(lines.size() == 3 * kRounds + 1);
+  for (std::size_t i{0}; i < lines.size(); ++i) {
+    const auto expected = Expected(static_cast<std::uint32_t>(i / 3), static_cast<std::uint32_t>(i % 3));
+    if (lines[i].find("|" + expected + " ") == std::string::npos) {
+      VITO_AP_CHECK(lines[i].find("|" + expected + " ") != std::string::npos);
+      std::fprintf(stderr, "line %zu: %s\n", i, lines[i].c_str());
+      break;
+    }
+  }
+  return ara::test::Result();
+}
@@ -0,0 +1,264 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logging_handler.h"
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+using namespace std::chrono_literals;
+
+constexpr auto kTimeout{5s};
+/// @brief HTYP2 of a verbose message with ECU, application and context ids: version 2, WEID and WACID
+constexpr std::uint32_t kVerboseHeaderType{0x4C};
+
+/// @brief Wait until condition holds, for at most kTimeout.
+bool WaitFor(const std::function<bool()>& condition) {
+  const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(5ms);
+  }
+  return true;
+}
+
+/// @brief Create a socket bound to 127.0.0.1 at port, or at a free port if it is 0.
+int Bind(int type, std::uint16_t port) {
+  const int fd{::socket(AF_INET, type | SOCK_CLOEXEC, 0)};
+  const int reuse{1};
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof reuse);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof address) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+std::uint16_t PortOf(int fd) {
+  sockaddr_in address{};
+  socklen_t length{sizeof address};
+  ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+  return ntohs(address.sin_port);
+}
+
+void Emit(NetworkHandler& handler, std::uint32_t index) {
+  auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "NET");
+  (void)message->AddArgument(core::StringView{"network handler test message"});
+  (void)message->AddArgument(index);
+  handler.Emit(std::move(message));
+}
+
+/// @brief Split received bytes into DLT messages by their LEN field and collect the index each message carries as its
+/// last argument. Incomplete messages are left in bytes.
+/// @return false if the bytes are not a sequence of verbose messages
+bool ParseMessages(std::vector<std::uint8_t>& bytes, std::vector<std::uint32_t>& indices) {
+  std::size_t offset{0};
+  while (bytes.size() - offset >= 7) {
+    const auto* message = bytes.data() + offset;
+    const std::uint32_t header_type{static_cast<std::uint32_t>(message[0] << 24 | message[1] << 16 |
+                                                               message[2] << 8 | message[3])};
+    const std::size_t length{static_cast<std::size_t>(message[5] << 8 | message[6])};
+    if (header_type != kVerboseHeaderType || length < 7 + sizeof(std::uint32_t)) {
+      return false;
+    }
+    if (bytes.size() - offset < length) {
+      break;
+    }
+    std::uint32_t index;
+    std::memcpy(&index, message + length - sizeof index, sizeof index);
+    indices.push_back(dlt::LittleEndian(index));
+    offset += length;
+  }
+  bytes.erase(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(offset));
+  return true;
+}
+
+/// @brief Read from a TCP connection until the messages first to last (inclusive) arrived, in order.
+bool ReceiveStream(int connection, std::uint32_t first, std::uint32_t last) {
+  std::vector<std::uint8_t> bytes;
+  std::vector<std::uint32_t> indices;
+  const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+  while (indices.size() < last - first + 1 && std::chrono::steady_clock::now() < deadline) {
+    pollfd poll_fd{connection, POLLIN, 0};
+    if (::poll(&poll_fd, 1, 100) <= 0) {
+      continue;
+    }
+    std::array<std::uint8_t, 4096> chunk;
+    const auto received = ::recv(connection, chunk.data(), chunk.size(), 0);
+    if (received <= 0) {
+      return false;
+    }
+    bytes.insert(bytes.end(), chunk.begin(), chunk.begin() + received);
+    if (!ParseMessages(bytes, indices)) {
+      return false;
+    }
+  }
+  for (std::uint32_t i{0}; i < indices.size(); ++i) {
+    if (indices[i] != first + i) {
+      return false;
+    }
+  }
+  return indices.size() == last - first + 1 && bytes.empty();
+}
+
+/// @brief Receive datagrams until the messages first to last (inclusive) arrived; earlier ones are skipped.
+/// @param datagram_size the largest datagram allowed
+/// @return the number of datagrams those messages came in, or 0 if one was not a whole number of messages
+std::size_t ReceiveDatagrams(int fd, std::uint32_t first, std::uint32_t last, std::size_t datagram_size) {
+  std::uint32_t next{first};
+  std::size_t datagrams{0};
+  const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+  while (next <= last && std::chrono::steady_clock::now() < deadline) {
+    pollfd poll_fd{fd, POLLIN, 0};
+    if (::poll(&poll_fd, 1, 100) <= 0) {
+      continue;
+    }
+    std::vector<std::uint8_t> bytes(65536);
+    const auto received = ::recv(fd, bytes.data(), bytes.size(), 0);
+    if (received <= 0 || static_cast<std::size_t>(received) > datagram_size) {
+      return 0;
+    }
+    bytes.resize(static_cast<std::size_t>(received));
+    std::vector<std::uint32_t> indices;
+    // each datagram holds whole messages
+    if (!ParseMessages(bytes, indices) || !bytes.empty()) {
+      return 0;
+    }
+    for (const auto index : indices) {
+      if (index == next) {
+        ++next;
+      }
+    }
+    ++datagrams;
+  }
+  return next > last ? datagrams : 0;
+}
+
+void TestTcp() {
+  const int listener{Bind(SOCK_STREAM, 0)};
+  VITO_AP_CHECK(listener >= 0);
+  NetworkConfig config;
+  config.protocol = NetworkProtocol::kTcp;
+  config.port = PortOf(listener);
+  config.flush_interval = 10ms;
+  config.reconnect_interval = 50ms;
+
+  auto opened = NetworkHandler::Open(config);
+  VITO_AP_CHECK(opened.HasValue());
+  if (!opened) {
+    return;
+  }
+  auto owner = std::move(opened).Value();
+  auto& handler = *owner;
+
+  // bound but not listening: the connection is refused, and the messages are kept until a later one succeeds
+  VITO_AP_CHECK(handler.GetClientState() != ClientState::kConnected);
+  VITO_AP_CHECK(WaitFor([&handler] { return handler.GetClientState() == ClientState::kNotConnected; }));
+  for (std::uint32_t i{0}; i < 100; ++i) {
+    Emit(handler, i);
+  }
+
+  VITO_AP_CHECK(::listen(listener, 1) == 0);
+  VITO_AP_CHECK(WaitFor([&handler] { return handler.GetClientState() == ClientState::kConnected; }));
+  int connection{::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC)};
+  VITO_AP_CHECK(ReceiveStream(connection, 0, 99));
+  for (std::uint32_t i{100}; i < 200; ++i) {
+    Emit(handler, i);
+  }
+  VITO_AP_CHECK(ReceiveStream(connection, 100, 199));
+
+  // the receiver goes away: the handler notices while idle, reconnects and sends what was logged meanwhile
+  ::close(connection);
+  VITO_AP_CHECK(WaitFor([&handler] { return handler.GetClientState() == ClientState::kNotConnected; }));
+  for (std::uint32_t i{200}; i < 300; ++i) {
+    Emit(handler, i);
+  }
+  VITO_AP_CHECK(WaitFor([&handler] { return handler.GetClientState() == ClientState::kConnected; }));
+  connection = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+  VITO_AP_CHECK(ReceiveStream(connection, 200, 299));
+  VITO_AP_CHECK(handler.Dropped() == 0);
+
+  owner.reset();
+  ::close(connection);
+  ::close(listener);
+}
+
+void TestUdp() {
+  int receiver{Bind(SOCK_DGRAM, 0)};
+  VITO_AP_CHECK(receiver >= 0);
+  NetworkConfig config;
+  config.protocol = NetworkProtocol::kUdp;
+  config.port = PortOf(receiver);
+  config.datagram_size = 512;
+  config.flush_interval = 10ms;
+  config.reconnect_interval = 50ms;
+
+  auto opened = NetworkHandler::Open(config);
+  VITO_AP_CHECK(opened.HasValue());
+  if (!opened) {
+    return;
+  }
+  auto owner = std::move(opened).Value();
+  auto& handler = *owner;
+
+  // nothing is known about a UDP receiver before datagrams were sent to it
+  std::this_thread::sleep_for(50ms);
+  VITO_AP_CHECK(handler.GetClientState() == ClientState::kUnknown);
+
+  for (std::uint32_t i{0}; i < 100; ++i) {
+    Emit(handler, i);
+  }
+  const auto datagrams = ReceiveDatagrams(receiver, 0, 99, config.datagram_size);
+  VITO_AP_CHECK(datagrams > 0);
+  // several messages are packed per datagram
+  VITO_AP_CHECK(datagrams < 50);
+  VITO_AP_CHECK(WaitFor([&handler] { return handler.GetClientState() == ClientState::kConnected; }));
+
+  // without a receiver the kernel reports the port unreachable on a later send
+  ::close(receiver);
+  std::uint32_t index{1000};
+  VITO_AP_CHECK(WaitFor([&handler, &index] {
+    Emit(handler, index++);
+    return handler.GetClientState() == ClientState::kNotConnected;
+  }));
+
+  receiver = Bind(SOCK_DGRAM, config.port);
+  VITO_AP_CHECK(receiver >= 0);
+  for (std::uint32_t i{2000}; i < 2100; ++i) {
+    Emit(handler, i);
+  }
+  VITO_AP_CHECK(ReceiveDatagrams(receiver, 2000, 2099, config.datagram_size) > 0);
+  VITO_AP_CHECK(WaitFor([&handler] { return handler.GetClientState() == ClientState::kConnected; }));
+
+  owner.reset();
+  ::close(receiver);
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["NETWORK"], "AppId": "TEST"})");
+  VITO_AP_CHECK(LogConfig::Instance().Init("MANIFEST.json").HasValue());
+
+  TestTcp();
+  TestUdp();
+  return ara::test::Result();
+}
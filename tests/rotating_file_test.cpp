@@ -0,0 +1,73 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logging_handler.h"
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+
+constexpr std::size_t kSegmentSize{1 << 16};
+
+bool Exists(const core::String& path) { return ::access(path.c_str(), F_OK) == 0; }
+
+/// @brief Write about segments segments worth of messages through a RotatingFileHandler, closing it at the end.
+void WriteSegments(const FileConfig& config, std::size_t segments) {
+  auto handler = FileHandler::Open<RotatingFileHandler>(config);
+  VITO_AP_CHECK(handler.HasValue());
+  if (!handler) {
+    return;
+  }
+  std::size_t written{0};
+  for (std::uint32_t i{0}; written < segments * kSegmentSize; ++i) {
+    auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "ROT");
+    (void)message->AddArgument(core::StringView{"rotating file test message"});
+    (void)message->AddArgument(i);
+    const auto size = message->ToString().size() + 1;
+    (*handler)->Emit(std::move(message));
+    // a pause per segment gives the worker time to open the next one, or the rollover would be postponed
+    if ((written + size) / kSegmentSize != written / kSegmentSize) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    }
+    written += size;
+  }
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "TEST"})");
+  VITO_AP_CHECK(LogConfig::Instance().Init("MANIFEST.json").HasValue());
+
+  FileConfig config;
+  config.path = "rotating.log";
+  config.buffer_size = 1 << 12;
+  config.rotation.max_bytes = kSegmentSize;
+  config.rotation.backup_count = 3;
+  for (const char* name : {"rotating.log", "rotating.log.1", "rotating.log.2", "rotating.log.3", "rotating.log.4"}) {
+    ::unlink(name);
+  }
+
+  // buffers that cannot be allocated are reported rather than written through
+  auto unallocated = config;
+  unallocated.buffer_size = std::size_t{1} << 60;
+  VITO_AP_CHECK(!FileHandler::Open<RotatingFileHandler>(unallocated).HasValue());
+
+  // fewer segments than backups: the archives are numbered from 1 without gaps
+  WriteSegments(config, 2);
+  VITO_AP_CHECK(Exists("rotating.log") && Exists("rotating.log.1"));
+  VITO_AP_CHECK(!Exists("rotating.log.3"));
+
+  // more segments than backups: only backup_count archives are kept
+  WriteSegments(config, 8);
+  for (const char* name : {"rotating.log", "rotating.log.1", "rotating.log.2", "rotating.log.3"}) {
+    VITO_AP_CHECK(Exists(name));
+  }
+  VITO_AP_CHECK(!Exists("rotating.log.4"));
+  VITO_AP_CHECK(!Exists("rotating.log.next"));
+  return ara::test::Result();
+}
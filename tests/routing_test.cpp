@@ -0,0 +1,118 @@
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ara/log/context_registry.h"
+#include "ara/log/flight_recorder.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logger.h"
+#include "ara/log/logger_manager.h"
+#include "ara/log/logging_handler.h"
+#include "test_util.h"
+
+namespace {
+using ara::log::LogLevel;
+
+constexpr const char* kFile{"routing.log"};
+constexpr const char* kRing{"routing.fdr"};
+
+bool Init(const std::string& routes) {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE", "FLIGHT_RECORDER"], "AppId": "TEST",
+                              "File": {"Path": "routing.log"}, "FlightRecorder": {"Path": "routing.fdr"},
+                              "Routes": )" +
+                           routes + "}");
+  return ara::log::LogConfig::Instance().Init("MANIFEST.json").HasValue();
+}
+
+/// @brief Return the texts of the messages the file sink took.
+std::vector<std::string> ReadFile() {
+  for (const auto& handler : ara::log::LoggerManager::Instance().GetLoggingHandlers()) {
+    if (auto* const file_handler = dynamic_cast<ara::log::FileHandler*>(handler.get())) {
+      file_handler->Flush();
+    }
+  }
+  std::vector<std::string> texts;
+  std::ifstream file{kFile};
+  for (std::string line; std::getline(file, line);) {
+    texts.push_back(line.substr(line.rfind('|') + 1, line.find_last_not_of(' ') - line.rfind('|')));
+  }
+  return texts;
+}
+
+/// @brief Return the texts of the messages the flight recorder took, which are all of the form "<context> <level>".
+std::vector<std::string> ReadRing(const std::vector<std::string>& candidates) {
+  std::vector<std::string> texts;
+  (void)ara::log::flight_recorder::Read(kRing, [&](ara::core::Span<const ara::core::Byte> message) {
+    const std::string bytes{reinterpret_cast<const char*>(message.data()), message.size()};
+    for (const auto& candidate : candidates) {
+      if (bytes.find(candidate) != std::string::npos) {
+        texts.push_back(candidate);
+      }
+    }
+  });
+  return texts;
+}
+
+void TestParseSinks() {
+  // unknown sinks, and levels, are configuration errors
+  VITO_AP_CHECK(!Init(R"([{"Level": "ERROR", "Sinks": ["FILE", "SYSLOG"]}])"));
+  VITO_AP_CHECK(!Init(R"([{"Level": "SEVERE", "Sinks": ["FILE"]}])"));
+  VITO_AP_CHECK(Init(R"([{"Level": "ERROR", "Sinks": ["FILE", "FLIGHT_RECORDER"]}, {"Context": "CTXA"}])"));
+  const auto& routes = ara::log::LogConfig::Instance().Routes();
+  VITO_AP_CHECK(routes.size() == 2);
+  if (routes.size() == 2) {
+    VITO_AP_CHECK(routes[0].ctx_id.empty() && routes[0].level == LogLevel::kError && routes[0].sinks == 0b11);
+    // no sinks named is all of them, and no level all levels
+    VITO_AP_CHECK(routes[1].ctx_id == "CTXA" && routes[1].level == LogLevel::kVerbose && routes[1].sinks == 0b11);
+  }
+}
+
+void TestRoutes() {
+  // CTXA is routed by its own rule alone; the rules for all contexts route CTXB
+  VITO_AP_CHECK(Init(R"([{"Context": "CTXA", "Level": "DEBUG", "Sinks": ["FILE"]},
+                         {"Level": "ERROR", "Sinks": ["FLIGHT_RECORDER"]},
+                         {"Level": "WARN", "Sinks": ["FILE"]}])"));
+  ::unlink(kFile);
+  ::unlink(kRing);
+  VITO_AP_CHECK(ara::log::LoggerManager::Instance().Init().HasValue());
+
+  auto& ctxa = ara::log::CreateLogger("CTXA", "routed context", LogLevel::kVerbose);
+  auto& ctxb = ara::log::CreateLogger("CTXB", "other context", LogLevel::kVerbose);
+  // nothing is built for levels no sink takes
+  VITO_AP_CHECK(ctxa.IsEnabled(LogLevel::kDebug) && !ctxa.IsEnabled(LogLevel::kVerbose));
+  VITO_AP_CHECK(ctxb.IsEnabled(LogLevel::kWarn) && !ctxb.IsEnabled(LogLevel::kInfo));
+
+  const std::vector<std::pair<LogLevel, std::string>> levels{
+      {LogLevel::kError, "ERROR"}, {LogLevel::kWarn, "WARN"}, {LogLevel::kDebug, "DEBUG"}};
+  std::vector<std::string> candidates;
+  for (auto* const logger : {&ctxa, &ctxb}) {
+    for (const auto& [level, name] : levels) {
+      const auto text = std::string{logger == &ctxa ? "CTXA " : "CTXB "} + name;
+      logger->WithLevel(level) << text;
+      candidates.push_back(text);
+    }
+  }
+
+  const auto file = ReadFile();
+  VITO_AP_CHECK((file == std::vector<std::string>{"CTXA ERROR", "CTXA WARN", "CTXA DEBUG", "CTXB ERROR", "CTXB WARN"}));
+  const auto ring = ReadRing(candidates);
+  // not "CTXA ERROR", which a rule for all contexts would send
+  VITO_AP_CHECK((ring == std::vector<std::string>{"CTXB ERROR"}));
+
+  // a threshold set on the logger pins it against later changes of the default threshold
+  ctxa.SetThreshold(LogLevel::kWarn);
+  ara::log::LoggerManager::Instance().GetContexts().SetDefaultThreshold(LogLevel::kError);
+  VITO_AP_CHECK(ctxa.IsEnabled(LogLevel::kWarn) && !ctxa.IsEnabled(LogLevel::kInfo));
+  VITO_AP_CHECK(!ctxb.IsEnabled(LogLevel::kWarn) && ctxb.IsEnabled(LogLevel::kError));
+  ara::log::LoggerManager::Instance().Deinit();
+}
+}  // namespace
+
+int main() {
+  TestParseSinks();
+  TestRoutes();
+  return ara::test::Result();
+}
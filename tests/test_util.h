@@ -0,0 +1,37 @@
+#ifndef VITO_AP_TEST_UTIL_H_
+#define VITO_AP_TEST_UTIL_H_
+
+#include <cstdio>
+#include <fstream>
+#include <string_view>
+
+namespace ara::test {
+/// @brief number of failed checks; main() returns Result(), which is what ctest looks at
+inline int failures{0};
+
+inline void Check(bool condition, const char* expression, const char* file, int line) {
+  if (!condition) {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    ++failures;
+  }
+}
+
+/// @brief Write the manifest read by ara::core::Initialize() into the working directory, which add_test gives each
+/// test on its own.
+inline void WriteManifest(std::string_view json) {
+  std::ofstream{"MANIFEST.json", std::ios::trunc} << json;
+}
+
+/// @brief Report the failed checks and return the exit code of the test.
+inline int Result() {
+  if (failures > 0) {
+    std::fprintf(stderr, "%d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
+}  // namespace ara::test
+
+#define VITO_AP_CHECK(condition) ::ara::test::Check((condition), #condition, __FILE__, __LINE__)
+
+#endif  // !VITO_AP_TEST_UTIL_H_
@@ -0,0 +1,130 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/log/dlt_message.h"
+#include "ara/log/log_config.h"
+#include "ara/log/logging_handler.h"
+#include "test_util.h"
+
+namespace {
+using namespace ara;
+using namespace ara::log;
+using namespace std::chrono_literals;
+
+constexpr const char* kPath{"timed.log"};
+/// @brief length of "YYYY-MM-DD HH:MM:SS", at the start of each line and at the end of each archive name
+constexpr std::size_t kSecondLength{19};
+
+/// @brief A segment as read back: the second each of its lines was logged in, and the index each carries.
+struct Segment {
+  std::string name;
+  std::vector<std::string> seconds;
+  std::vector<std::uint32_t> indices;
+};
+
+Segment ReadSegment(const std::string& name) {
+  Segment segment{name, {}, {}};
+  std::ifstream file{name};
+  for (std::string line; std::getline(file, line);) {
+    segment.seconds.push_back(line.substr(0, kSecondLength));
+    segment.indices.push_back(static_cast<std::uint32_t>(std::stoul(line.substr(line.rfind(' ', line.size() - 3)))));
+  }
+  return segment;
+}
+
+/// @brief Return the archives, oldest first.
+std::vector<std::string> Archives() {
+  std::vector<std::string> archives;
+  for (const auto& entry : std::filesystem::directory_iterator{"."}) {
+    const auto name = entry.path().filename().string();
+    if (name.starts_with(std::string{kPath} + ".")) {
+      archives.push_back(name);
+    }
+  }
+  std::sort(archives.begin(), archives.end());
+  return archives;
+}
+
+/// @brief Check that all lines of a segment were logged in the same second, save the first, which may have been
+/// created just before the rollover it was written after.
+bool WithinOneSecond(const Segment& segment, const std::string& second) {
+  return !segment.seconds.empty() &&
+         std::all_of(segment.seconds.begin() + 1, segment.seconds.end(), [&](const auto& s) { return s == second; });
+}
+}  // namespace
+
+int main() {
+  ara::test::WriteManifest(R"({"EcuId": "ECU1", "LogSinks": ["FILE"], "AppId": "TEST"})");
+  VITO_AP_CHECK(LogConfig::Instance().Init("MANIFEST.json").HasValue());
+  for (const auto& name : Archives()) {
+    ::unlink(name.c_str());
+  }
+  ::unlink(kPath);
+
+  FileConfig config;
+  config.path = kPath;
+  config.buffer_size = 1 << 12;
+  // every message is written as it comes, so that it lands in the segment of the second it was logged in
+  config.flush_level = LogLevel::kVerbose;
+  config.rotation.interval = 1s;
+  config.rotation.backup_count = 2;
+
+  // four rollovers or more, one per second
+  {
+    auto handler = FileHandler::Open<TimedRotatingFileHandler>(config);
+    VITO_AP_CHECK(handler.HasValue());
+    if (!handler) {
+      return ara::test::Result();
+    }
+    const auto end = std::chrono::system_clock::now() + 4500ms;
+    for (std::uint32_t i{0}; std::chrono::system_clock::now() < end; ++i) {
+      auto message = dlt::Message::VerboseModeLogMessage(LogLevel::kInfo, "ROT");
+      (void)message->AddArgument(core::StringView{"timed rotating file test message"});
+      (void)message->AddArgument(i);
+      (*handler)->Emit(std::move(message));
+      std::this_thread::sleep_for(20ms);
+    }
+  }
+
+  // only the newest backup_count archives are kept, and no next segment is left behind
+  const auto archives = Archives();
+  VITO_AP_CHECK(archives.size() == 2);
+  VITO_AP_CHECK(std::find(archives.begin(), archives.end(), std::string{kPath} + ".next") == archives.end());
+  if (archives.size() != 2) {
+    return ara::test::Result();
+  }
+
+  std::vector<Segment> segments;
+  for (const auto& archive : archives) {
+    segments.push_back(ReadSegment(archive));
+  }
+  segments.push_back(ReadSegment(kPath));
+  for (std::size_t i{0}; i < segments.size(); ++i) {
+    const auto& segment = segments[i];
+    VITO_AP_CHECK(!segment.indices.empty());
+    if (segment.indices.empty()) {
+      continue;
+    }
+    // rollovers happen at whole seconds, so each segment holds the messages of one second
+    const auto second = segment.seconds.back();
+    VITO_AP_CHECK(WithinOneSecond(segment, second));
+    if (i + 1 < segments.size()) {
+      // archives are named by the local time the segment started, "path.YYYY-MM-DD_HH-MM-SS"
+      auto suffix = segment.name.substr(segment.name.size() - kSecondLength);
+      std::replace(suffix.begin(), suffix.end(), '_', ' ');
+      std::replace(suffix.begin() + 11, suffix.end(), '-', ':');
+      VITO_AP_CHECK(suffix == second);
+      // the segments are consecutive, without a message lost at the rollover
+      VITO_AP_CHECK(!segments[i + 1].indices.empty() && segments[i + 1].indices.front() == segment.indices.back() + 1);
+      VITO_AP_CHECK(segments[i + 1].seconds.back() > second);
+    }
+  }
+  return ara::test::Result();
+}